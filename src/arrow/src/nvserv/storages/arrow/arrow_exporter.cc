@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/arrow/arrow_exporter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "nvserv/storages/execution_result.h"
+#include "nvserv/storages/postgres/pg_binary.h"
+#include "nvserv/storages/postgres/pg_execution_result.h"
+#include "nvserv/storages/postgres/pg_helper.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages::arrow)
+
+namespace {
+
+using postgres::PgResultSet;
+namespace pg = postgres::helper;
+namespace oid = postgres::helper::oid;
+
+void Check(const ::arrow::Status& status) {
+  if (!status.ok()) {
+    throw std::runtime_error("Arrow: " + status.ToString());
+  }
+}
+
+const PgResultSet& ResultSetOf(const ExecutionResult& result) {
+  if (result.Type() != StorageType::Postgres) {
+    throw std::invalid_argument("ArrowExporter only supports postgres result");
+  }
+  return *static_cast<const postgres::PgExecutionResult&>(result).ResultSet();
+}
+
+std::shared_ptr<::arrow::DataType> ArrowType(uint32_t type) {
+  switch (type) {
+    case oid::INT2:
+      return ::arrow::int16();
+    case oid::INT4:
+      return ::arrow::int32();
+    case oid::INT8:
+      return ::arrow::int64();
+    case oid::FLOAT4:
+      return ::arrow::float32();
+    case oid::FLOAT8:
+      return ::arrow::float64();
+    case oid::BOOL:
+      return ::arrow::boolean();
+    case oid::TIMESTAMP:
+      return ::arrow::timestamp(::arrow::TimeUnit::MICRO);
+    case oid::TIMESTAMPTZ:
+      return ::arrow::timestamp(::arrow::TimeUnit::MICRO, "UTC");
+    case oid::BYTEA:
+      return ::arrow::binary();
+    default:
+      return ::arrow::utf8();
+  }
+}
+
+template <typename T>
+T ParseText(std::string_view raw) {
+  T value;
+  auto end = raw.data() + raw.size();
+  auto [ptr, ec] = std::from_chars(raw.data(), end, value);
+  if (ec != std::errc() || ptr != end) {
+    throw std::invalid_argument("Malformed numeric value [" +
+                                std::string(raw) + "]");
+  }
+  return value;
+}
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  throw std::invalid_argument("Malformed bytea hex digit");
+}
+
+// Text format bytea "\x0a1b..." into bytes, reuses the buffer
+void DecodeHexBytea(std::string_view raw, std::string& bytes) {
+  if (raw.size() < 2 || raw[0] != '\\' || raw[1] != 'x' ||
+      raw.size() % 2 != 0) {
+    throw std::invalid_argument("Bytea is not in hex format");
+  }
+
+  bytes.resize((raw.size() - 2) / 2);
+  for (size_t i = 0; i < bytes.size(); i++) {
+    bytes[i] = static_cast<char>((HexValue(raw[2 + i * 2]) << 4) |
+                                 HexValue(raw[3 + i * 2]));
+  }
+}
+
+::arrow::Status Append(::arrow::BinaryBuilder& builder,
+                       std::string_view value) {
+  return builder.Append(value.data(), static_cast<int32_t>(value.size()));
+}
+
+// Fixed-width column, the builder is sized once for the chunk
+template <typename TBuilder, typename TDecode>
+std::shared_ptr<::arrow::Array> BuildFixed(TBuilder& builder,
+                                           const PgResultSet& result,
+                                           int column, int begin, int end,
+                                           TDecode&& decode) {
+  Check(builder.Reserve(end - begin));
+  for (int row = begin; row < end; row++) {
+    if (result.IsNull(row, column)) {
+      builder.UnsafeAppendNull();
+    } else {
+      builder.UnsafeAppend(decode(result.Value(row, column)));
+    }
+  }
+
+  std::shared_ptr<::arrow::Array> array;
+  Check(builder.Finish(&array));
+  return array;
+}
+
+// Variable-width column, offsets & data are sized once from field lengths
+template <typename TBuilder, typename TAppend>
+std::shared_ptr<::arrow::Array> BuildVariable(TBuilder& builder,
+                                              const PgResultSet& result,
+                                              int column, int begin, int end,
+                                              TAppend&& append) {
+  int64_t data_bytes = 0;
+  for (int row = begin; row < end; row++) {
+    if (!result.IsNull(row, column)) {
+      data_bytes += static_cast<int64_t>(result.Value(row, column).size());
+    }
+  }
+  Check(builder.Reserve(end - begin));
+  Check(builder.ReserveData(data_bytes));
+
+  for (int row = begin; row < end; row++) {
+    if (result.IsNull(row, column)) {
+      Check(builder.AppendNull());
+    } else {
+      append(result.Value(row, column));
+    }
+  }
+
+  std::shared_ptr<::arrow::Array> array;
+  Check(builder.Finish(&array));
+  return array;
+}
+
+std::shared_ptr<::arrow::Array> BuildColumn(const PgResultSet& result,
+                                            int column, int begin, int end) {
+  auto type = result.ColumnType(column);
+  auto binary = result.ColumnFormat(column) == 1;
+
+  switch (type) {
+    case oid::INT2: {
+      ::arrow::Int16Builder builder;
+      return BuildFixed(builder, result, column, begin, end,
+                        [&](std::string_view raw) {
+                          return binary ? static_cast<int16_t>(
+                                              pg::ReadInteger(raw, type))
+                                        : ParseText<int16_t>(raw);
+                        });
+    }
+    case oid::INT4: {
+      ::arrow::Int32Builder builder;
+      return BuildFixed(builder, result, column, begin, end,
+                        [&](std::string_view raw) {
+                          return binary ? static_cast<int32_t>(
+                                              pg::ReadInteger(raw, type))
+                                        : ParseText<int32_t>(raw);
+                        });
+    }
+    case oid::INT8: {
+      ::arrow::Int64Builder builder;
+      return BuildFixed(builder, result, column, begin, end,
+                        [&](std::string_view raw) {
+                          return binary ? pg::ReadInteger(raw, type)
+                                        : ParseText<int64_t>(raw);
+                        });
+    }
+    case oid::FLOAT4: {
+      ::arrow::FloatBuilder builder;
+      return BuildFixed(builder, result, column, begin, end,
+                        [&](std::string_view raw) {
+                          return binary ? static_cast<float>(
+                                              pg::ReadFloat(raw, type))
+                                        : ParseText<float>(raw);
+                        });
+    }
+    case oid::FLOAT8: {
+      ::arrow::DoubleBuilder builder;
+      return BuildFixed(builder, result, column, begin, end,
+                        [&](std::string_view raw) {
+                          return binary ? pg::ReadFloat(raw, type)
+                                        : ParseText<double>(raw);
+                        });
+    }
+    case oid::BOOL: {
+      ::arrow::BooleanBuilder builder;
+      return BuildFixed(builder, result, column, begin, end,
+                        [&](std::string_view raw) {
+                          return binary ? pg::ReadBool(raw) : raw == "t";
+                        });
+    }
+    case oid::TIMESTAMP:
+    case oid::TIMESTAMPTZ: {
+      ::arrow::TimestampBuilder builder(ArrowType(type),
+                                        ::arrow::default_memory_pool());
+      return BuildFixed(builder, result, column, begin, end,
+                        [&](std::string_view raw) {
+                          return binary ? pg::ReadTimestampMicros(raw)
+                                        : pg::ParseTimestampMicros(raw);
+                        });
+    }
+    case oid::BYTEA: {
+      ::arrow::BinaryBuilder builder;
+      std::string bytes;
+      return BuildVariable(builder, result, column, begin, end,
+                           [&](std::string_view raw) {
+                             if (binary) {
+                               Check(Append(builder, raw));
+                               return;
+                             }
+                             DecodeHexBytea(raw, bytes);
+                             Check(Append(builder, bytes));
+                           });
+    }
+    default: {
+      ::arrow::StringBuilder builder;
+      return BuildVariable(
+          builder, result, column, begin, end, [&](std::string_view raw) {
+            if (!binary || type == oid::TEXT || type == oid::VARCHAR ||
+                type == oid::BPCHAR || type == oid::NAME ||
+                type == oid::JSON || type == oid::XML) {
+              Check(Append(builder, raw));
+              return;
+            }
+            Check(Append(builder, pg::ReadAsText(raw, type)));
+          });
+    }
+  }
+}
+
+/// @brief Decode one chunk per ReadNext.
+class ResultBatchReader : public ::arrow::RecordBatchReader {
+ public:
+  ResultBatchReader(ArrowExporter exporter, ExecutionResultPtr result)
+                  : exporter_(exporter),
+                    result_(std::move(result)),
+                    schema_(exporter_.Schema(*result_)),
+                    offset_(0) {}
+
+  std::shared_ptr<::arrow::Schema> schema() const override {
+    return schema_;
+  }
+
+  ::arrow::Status ReadNext(
+      std::shared_ptr<::arrow::RecordBatch>* batch) override {
+    if (offset_ >= result_->RowCount()) {
+      batch->reset();
+      return ::arrow::Status::OK();
+    }
+
+    try {
+      *batch =
+          exporter_.ToRecordBatch(*result_, offset_, exporter_.ChunkRows());
+    } catch (const std::exception& e) {
+      return ::arrow::Status::Invalid(e.what());
+    }
+
+    offset_ += (*batch)->num_rows();
+    return ::arrow::Status::OK();
+  }
+
+ private:
+  ArrowExporter exporter_;
+  ExecutionResultPtr result_;
+  std::shared_ptr<::arrow::Schema> schema_;
+  int64_t offset_;
+};
+
+}  // namespace
+
+ArrowExporter::ArrowExporter(int64_t chunk_rows)
+                : chunk_rows_(chunk_rows > 0 ? chunk_rows
+                                             : DEFAULT_CHUNK_ROWS) {}
+
+int64_t ArrowExporter::ChunkRows() const {
+  return chunk_rows_;
+}
+
+std::shared_ptr<::arrow::Schema> ArrowExporter::Schema(
+    const ExecutionResult& result) const {
+  const auto& result_set = ResultSetOf(result);
+
+  ::arrow::FieldVector fields;
+  fields.reserve(static_cast<size_t>(result_set.Columns()));
+  for (int i = 0; i < result_set.Columns(); i++) {
+    fields.push_back(::arrow::field(result_set.ColumnName(i),
+                                    ArrowType(result_set.ColumnType(i))));
+  }
+  return ::arrow::schema(std::move(fields));
+}
+
+std::shared_ptr<::arrow::RecordBatch> ArrowExporter::ToRecordBatch(
+    const ExecutionResult& result, int64_t offset, int64_t rows) const {
+  const auto& result_set = ResultSetOf(result);
+
+  int64_t total = result_set.Rows();
+  if (offset < 0 || rows < 0 || offset > total) {
+    throw std::invalid_argument("ToRecordBatch range is out-of-bounds [" +
+                                std::to_string(offset) + ", " +
+                                std::to_string(rows) + "]");
+  }
+
+  auto begin = static_cast<int>(offset);
+  auto end = static_cast<int>(std::min(total, offset + rows));
+
+  ::arrow::ArrayVector arrays;
+  arrays.reserve(static_cast<size_t>(result_set.Columns()));
+  for (int i = 0; i < result_set.Columns(); i++) {
+    arrays.push_back(BuildColumn(result_set, i, begin, end));
+  }
+
+  return ::arrow::RecordBatch::Make(Schema(result), end - begin,
+                                    std::move(arrays));
+}
+
+std::vector<std::shared_ptr<::arrow::RecordBatch>>
+ArrowExporter::ToRecordBatches(const ExecutionResult& result) const {
+  std::vector<std::shared_ptr<::arrow::RecordBatch>> batches;
+  int64_t total = result.RowCount();
+  batches.reserve(
+      static_cast<size_t>((total + chunk_rows_ - 1) / chunk_rows_));
+
+  for (int64_t offset = 0; offset < total; offset += chunk_rows_) {
+    batches.push_back(ToRecordBatch(result, offset, chunk_rows_));
+  }
+  return batches;
+}
+
+std::shared_ptr<::arrow::Table> ArrowExporter::ToTable(
+    const ExecutionResult& result) const {
+  auto table =
+      ::arrow::Table::FromRecordBatches(Schema(result), ToRecordBatches(result));
+  Check(table.status());
+  return table.ValueOrDie();
+}
+
+std::shared_ptr<::arrow::RecordBatchReader> ArrowExporter::ToReader(
+    ExecutionResultPtr result) const {
+  if (!result) {
+    throw std::invalid_argument("ToReader result is null");
+  }
+  return std::make_shared<ResultBatchReader>(*this, std::move(result));
+}
+
+NVSERV_END_NAMESPACE
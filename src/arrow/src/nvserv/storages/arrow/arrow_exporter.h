@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <arrow/api.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/declare.h"
+
+// Apache Arrow lives in ::arrow, always qualified from this namespace.
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages::arrow)
+
+/// @brief Convert ExecutionResult into Arrow RecordBatch in fixed-size
+/// chunks, decoded straight from the Postgres buffers (text or binary format)
+/// without RowResult objects.
+///
+/// Type mapping: int2/int4/int8 -> int16/int32/int64, float4/float8 ->
+/// float32/float64, bool -> boolean, timestamp(tz) -> timestamp[us](UTC),
+/// bytea -> binary, every other type -> utf8.
+/// Throws std::invalid_argument on non-Postgres result or malformed value.
+class ArrowExporter {
+ public:
+  static constexpr int64_t DEFAULT_CHUNK_ROWS = 65536;
+
+  explicit ArrowExporter(int64_t chunk_rows = DEFAULT_CHUNK_ROWS);
+
+  int64_t ChunkRows() const;
+
+  std::shared_ptr<::arrow::Schema> Schema(const ExecutionResult& result) const;
+
+  /// @brief Rows [offset, offset + rows) as one batch.
+  std::shared_ptr<::arrow::RecordBatch> ToRecordBatch(
+      const ExecutionResult& result, int64_t offset, int64_t rows) const;
+
+  /// @brief Every row, chunked by ChunkRows().
+  std::vector<std::shared_ptr<::arrow::RecordBatch>> ToRecordBatches(
+      const ExecutionResult& result) const;
+
+  std::shared_ptr<::arrow::Table> ToTable(const ExecutionResult& result) const;
+
+  /// @brief Stream the result chunk by chunk, a chunk is only decoded when
+  /// it is read. The reader keeps the result alive.
+  std::shared_ptr<::arrow::RecordBatchReader> ToReader(
+      ExecutionResultPtr result) const;
+
+ private:
+  int64_t chunk_rows_;
+};
+
+NVSERV_END_NAMESPACE
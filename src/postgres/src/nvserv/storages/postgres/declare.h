@@ -28,8 +28,12 @@ NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
 class PgServer;
 class PgTransaction;
+class PgReactor;
+class PgMultiplexer;
 
 using PgServerPtr = std::shared_ptr<PgServer>;
 using PgTransactionPtr = std::shared_ptr<PgTransaction>;
+using PgReactorPtr = std::shared_ptr<PgReactor>;
+using PgMultiplexerPtr = std::shared_ptr<PgMultiplexer>;
 
 NVSERV_END_NAMESPACE
\ No newline at end of file
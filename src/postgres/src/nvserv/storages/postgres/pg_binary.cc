@@ -0,0 +1,616 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_binary.h"
+
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <pqxx/pqxx>
+#include <stdexcept>
+#include <type_traits>
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres::helper)
+
+namespace {
+
+// 2000-01-01 00:00:00 UTC in unix microseconds
+constexpr int64_t PG_EPOCH_MICROS = 946684800LL * 1000000LL;
+
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+template <typename T>
+std::string WriteBigEndian(T value) {
+  std::string out(sizeof(T), '\0');
+  for (size_t i = 0; i < sizeof(T); i++) {
+    out[sizeof(T) - 1 - i] = static_cast<char>(value & 0xFF);
+    value >>= 8;
+  }
+  return out;
+}
+
+// Caller checks the size
+uint64_t LoadBigEndian(std::string_view value) {
+  uint64_t result = 0;
+  for (auto c : value) {
+    result = (result << 8) | static_cast<unsigned char>(c);
+  }
+  return result;
+}
+
+uint64_t ReadBigEndian(std::string_view value, size_t size) {
+  if (value.size() != size) {
+    throw std::invalid_argument("Binary value has " +
+                                std::to_string(value.size()) +
+                                " bytes, expected " + std::to_string(size));
+  }
+
+  return LoadBigEndian(value);
+}
+
+template <typename T>
+void AppendBigEndian(std::string& out, T value) {
+  for (size_t i = sizeof(T); i > 0; i--) {
+    out.push_back(static_cast<char>((value >> ((i - 1) * 8)) & 0xFF));
+  }
+}
+
+uint32_t ReadWord(std::string_view value, size_t& pos) {
+  if (value.size() - pos < 4) {
+    throw std::invalid_argument("Binary array is truncated");
+  }
+  auto word = static_cast<uint32_t>(LoadBigEndian(value.substr(pos, 4)));
+  pos += 4;
+  return word;
+}
+
+// Empty arrays have no dimension
+void AppendArrayHeader(std::string& out, uint32_t element_type,
+                       size_t size) {
+  if (size > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    throw std::invalid_argument("Array has too many elements");
+  }
+  AppendBigEndian<uint32_t>(out, size == 0 ? 0 : 1);  // dimensions
+  AppendBigEndian<uint32_t>(out, 0);                   // has null flag
+  AppendBigEndian<uint32_t>(out, element_type);
+  if (size != 0) {
+    AppendBigEndian(out, static_cast<uint32_t>(size));
+    AppendBigEndian<uint32_t>(out, 1);  // lower bound
+  }
+}
+
+template <typename TBits, typename T>
+std::string WriteFixedArray(const std::vector<T>& values,
+                            uint32_t element_type) {
+  std::string out;
+  out.reserve(20 + values.size() * (4 + sizeof(TBits)));
+  AppendArrayHeader(out, element_type, values.size());
+  for (auto value : values) {
+    TBits bits;
+    if constexpr (std::is_floating_point_v<T>) {
+      std::memcpy(&bits, &value, sizeof(bits));
+    } else {
+      bits = static_cast<TBits>(value);
+    }
+    AppendBigEndian(out, static_cast<uint32_t>(sizeof(TBits)));
+    AppendBigEndian(out, bits);
+  }
+  return out;
+}
+
+void AppendQuoted(std::string& out, std::string_view value) {
+  out.push_back('"');
+  for (auto c : value) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+    }
+    out.push_back(c);
+  }
+  out.push_back('"');
+}
+
+template <typename T>
+std::string FormatNumericArray(const std::vector<T>& values) {
+  std::string out;
+  out.push_back('{');
+  for (size_t i = 0; i < values.size(); i++) {
+    if (i > 0) {
+      out.push_back(',');
+    }
+    out.append(pqxx::to_string(values[i]));
+  }
+  out.push_back('}');
+  return out;
+}
+
+bool IsNullLiteral(std::string_view value) {
+  constexpr std::string_view null_literal = "null";
+  if (value.size() != null_literal.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < value.size(); i++) {
+    if (std::tolower(static_cast<unsigned char>(value[i])) != null_literal[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsTextType(uint32_t type) {
+  return type == oid::TEXT || type == oid::VARCHAR || type == oid::BPCHAR ||
+         type == oid::NAME;
+}
+
+std::string ReadArrayAsText(std::string_view value) {
+  uint32_t element_type;
+  auto elements = ReadArray(value, element_type);
+  auto quote = IsTextType(element_type);
+
+  std::string out;
+  out.push_back('{');
+  for (size_t i = 0; i < elements.size(); i++) {
+    if (i > 0) {
+      out.push_back(',');
+    }
+    if (quote) {
+      AppendQuoted(out, elements[i]);
+    } else {
+      out.append(ReadAsText(elements[i], element_type));
+    }
+  }
+  out.push_back('}');
+  return out;
+}
+
+}  // namespace
+
+std::string WriteInt16(int16_t value) {
+  return WriteBigEndian(static_cast<uint16_t>(value));
+}
+
+std::string WriteInt32(int32_t value) {
+  return WriteBigEndian(static_cast<uint32_t>(value));
+}
+
+std::string WriteInt64(int64_t value) {
+  return WriteBigEndian(static_cast<uint64_t>(value));
+}
+
+std::string WriteFloat4(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return WriteBigEndian(bits);
+}
+
+std::string WriteFloat8(double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return WriteBigEndian(bits);
+}
+
+std::string WriteBool(bool value) {
+  return std::string(1, value ? '\1' : '\0');
+}
+
+std::string WriteTimestamp(
+    const std::chrono::system_clock::time_point& value) {
+  if (value == std::chrono::system_clock::time_point::max()) {
+    return WriteInt64(TIMESTAMP_INFINITY);
+  }
+  if (value == std::chrono::system_clock::time_point::min()) {
+    return WriteInt64(TIMESTAMP_NEGATIVE_INFINITY);
+  }
+
+  auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                    value.time_since_epoch())
+                    .count();
+  return WriteInt64(static_cast<int64_t>(micros) - PG_EPOCH_MICROS);
+}
+
+std::string WriteArray(const std::vector<int16_t>& values) {
+  return WriteFixedArray<uint16_t>(values, oid::INT2);
+}
+
+std::string WriteArray(const std::vector<int32_t>& values) {
+  return WriteFixedArray<uint32_t>(values, oid::INT4);
+}
+
+std::string WriteArray(const std::vector<int64_t>& values) {
+  return WriteFixedArray<uint64_t>(values, oid::INT8);
+}
+
+std::string WriteArray(const std::vector<float>& values) {
+  return WriteFixedArray<uint32_t>(values, oid::FLOAT4);
+}
+
+std::string WriteArray(const std::vector<double>& values) {
+  return WriteFixedArray<uint64_t>(values, oid::FLOAT8);
+}
+
+std::string WriteArray(const std::vector<std::string>& values) {
+  size_t bytes = 20;
+  for (const auto& value : values) {
+    bytes += 4 + value.size();
+  }
+
+  std::string out;
+  out.reserve(bytes);
+  AppendArrayHeader(out, oid::TEXT, values.size());
+  for (const auto& value : values) {
+    if (value.size() >
+        static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      throw std::invalid_argument("Array element is too large");
+    }
+    AppendBigEndian(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+  }
+  return out;
+}
+
+uint32_t ArrayElementType(uint32_t array_type) {
+  switch (array_type) {
+    case oid::INT2_ARRAY:
+      return oid::INT2;
+    case oid::INT4_ARRAY:
+      return oid::INT4;
+    case oid::INT8_ARRAY:
+      return oid::INT8;
+    case oid::FLOAT4_ARRAY:
+      return oid::FLOAT4;
+    case oid::FLOAT8_ARRAY:
+      return oid::FLOAT8;
+    case oid::TEXT_ARRAY:
+      return oid::TEXT;
+    case oid::BPCHAR_ARRAY:
+      return oid::BPCHAR;
+    case oid::VARCHAR_ARRAY:
+      return oid::VARCHAR;
+    default:
+      return 0;
+  }
+}
+
+std::vector<std::string_view> ReadArray(std::string_view value,
+                                        uint32_t& element_type) {
+  size_t pos = 0;
+  auto dimensions = static_cast<int32_t>(ReadWord(value, pos));
+  ReadWord(value, pos);  // has null flag, nulls are checked per element
+  element_type = ReadWord(value, pos);
+
+  std::vector<std::string_view> elements;
+  if (dimensions == 0) {
+    return elements;
+  }
+  if (dimensions != 1) {
+    throw std::invalid_argument("Binary array has " +
+                                std::to_string(dimensions) +
+                                " dimensions, expected 1");
+  }
+
+  auto size = static_cast<int32_t>(ReadWord(value, pos));
+  ReadWord(value, pos);  // lower bound
+  if (size < 0 || static_cast<size_t>(size) > (value.size() - pos) / 4) {
+    throw std::invalid_argument("Binary array is truncated");
+  }
+
+  elements.reserve(static_cast<size_t>(size));
+  for (int32_t i = 0; i < size; i++) {
+    auto length = static_cast<int32_t>(ReadWord(value, pos));
+    if (length < 0) {
+      throw std::invalid_argument("Binary array has null element");
+    }
+    if (value.size() - pos < static_cast<size_t>(length)) {
+      throw std::invalid_argument("Binary array is truncated");
+    }
+    elements.push_back(value.substr(pos, static_cast<size_t>(length)));
+    pos += static_cast<size_t>(length);
+  }
+  return elements;
+}
+
+int64_t ReadInteger(std::string_view value, uint32_t type) {
+  switch (type) {
+    case oid::INT2:
+      return static_cast<int16_t>(ReadBigEndian(value, 2));
+    case oid::INT4:
+      return static_cast<int32_t>(ReadBigEndian(value, 4));
+    case oid::INT8:
+      return static_cast<int64_t>(ReadBigEndian(value, 8));
+    default:
+      throw std::invalid_argument("Binary column type [" +
+                                  std::to_string(type) +
+                                  "] is not an integer");
+  }
+}
+
+double ReadFloat(std::string_view value, uint32_t type) {
+  switch (type) {
+    case oid::FLOAT4: {
+      auto bits = static_cast<uint32_t>(ReadBigEndian(value, 4));
+      float result;
+      std::memcpy(&result, &bits, sizeof(result));
+      return result;
+    }
+    case oid::FLOAT8: {
+      auto bits = ReadBigEndian(value, 8);
+      double result;
+      std::memcpy(&result, &bits, sizeof(result));
+      return result;
+    }
+    default:
+      return static_cast<double>(ReadInteger(value, type));
+  }
+}
+
+bool TryReadInteger(std::string_view value, uint32_t type, int64_t& result) {
+  switch (type) {
+    case oid::INT2:
+      if (value.size() != 2) {
+        return false;
+      }
+      result = static_cast<int16_t>(LoadBigEndian(value));
+      return true;
+    case oid::INT4:
+      if (value.size() != 4) {
+        return false;
+      }
+      result = static_cast<int32_t>(LoadBigEndian(value));
+      return true;
+    case oid::INT8:
+      if (value.size() != 8) {
+        return false;
+      }
+      result = static_cast<int64_t>(LoadBigEndian(value));
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool TryReadFloat(std::string_view value, uint32_t type, double& result) {
+  switch (type) {
+    case oid::FLOAT4: {
+      if (value.size() != 4) {
+        return false;
+      }
+      auto bits = static_cast<uint32_t>(LoadBigEndian(value));
+      float decoded;
+      std::memcpy(&decoded, &bits, sizeof(decoded));
+      result = decoded;
+      return true;
+    }
+    case oid::FLOAT8: {
+      if (value.size() != 8) {
+        return false;
+      }
+      auto bits = LoadBigEndian(value);
+      std::memcpy(&result, &bits, sizeof(result));
+      return true;
+    }
+    default: {
+      int64_t integer;
+      if (!TryReadInteger(value, type, integer)) {
+        return false;
+      }
+      result = static_cast<double>(integer);
+      return true;
+    }
+  }
+}
+
+bool ReadBool(std::string_view value) {
+  return ReadBigEndian(value, 1) != 0;
+}
+
+std::chrono::system_clock::time_point ReadTimestamp(
+    std::string_view value) {
+  return MicrosToTimePoint(ReadTimestampMicros(value));
+}
+
+int64_t ReadTimestampMicros(std::string_view value) {
+  auto micros = static_cast<int64_t>(ReadBigEndian(value, 8));
+  if (micros == TIMESTAMP_INFINITY || micros == TIMESTAMP_NEGATIVE_INFINITY) {
+    return micros;
+  }
+  return micros + PG_EPOCH_MICROS;
+}
+
+std::chrono::system_clock::time_point MicrosToTimePoint(int64_t micros) {
+  using std::chrono::system_clock;
+  if (micros == TIMESTAMP_INFINITY) {
+    return system_clock::time_point::max();
+  }
+  if (micros == TIMESTAMP_NEGATIVE_INFINITY) {
+    return system_clock::time_point::min();
+  }
+
+  constexpr auto max_micros =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          system_clock::duration::max())
+          .count();
+  constexpr auto min_micros =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          system_clock::duration::min())
+          .count();
+  if (micros > max_micros || micros < min_micros) {
+    throw std::out_of_range("Timestamp is beyond the system clock range");
+  }
+
+  return system_clock::time_point(
+      std::chrono::duration_cast<system_clock::duration>(
+          std::chrono::microseconds(micros)));
+}
+
+std::string ReadAsText(std::string_view value, uint32_t type) {
+  switch (type) {
+    case oid::TEXT:
+    case oid::VARCHAR:
+    case oid::BPCHAR:
+    case oid::NAME:
+    case oid::JSON:
+    case oid::XML:
+      return std::string(value);
+    case oid::JSONB:
+      // version byte followed by the json text
+      return value.empty() ? std::string() : std::string(value.substr(1));
+    case oid::BOOL:
+      return ReadBool(value) ? "t" : "f";
+    case oid::INT2:
+    case oid::INT4:
+    case oid::INT8:
+      return std::to_string(ReadInteger(value, type));
+    case oid::FLOAT4:
+      return pqxx::to_string(static_cast<float>(ReadFloat(value, type)));
+    case oid::FLOAT8:
+      return pqxx::to_string(ReadFloat(value, type));
+    case oid::UUID:
+      if (value.size() != 16) {
+        throw std::invalid_argument("Binary uuid must be 16 bytes");
+      }
+      return FormatUuid(reinterpret_cast<const unsigned char*>(value.data()));
+    case oid::BYTEA:
+      return FormatBytea(reinterpret_cast<const unsigned char*>(value.data()),
+                         value.size());
+    case oid::INT2_ARRAY:
+    case oid::INT4_ARRAY:
+    case oid::INT8_ARRAY:
+    case oid::FLOAT4_ARRAY:
+    case oid::FLOAT8_ARRAY:
+    case oid::TEXT_ARRAY:
+    case oid::BPCHAR_ARRAY:
+    case oid::VARCHAR_ARRAY:
+      return ReadArrayAsText(value);
+    default:
+      throw std::invalid_argument("Binary column type [" +
+                                  std::to_string(type) +
+                                  "] has no text conversion");
+  }
+}
+
+std::string FormatUuid(const unsigned char* bytes) {
+  std::string out;
+  out.reserve(36);
+  for (size_t i = 0; i < 16; i++) {
+    if (i == 4 || i == 6 || i == 8 || i == 10) {
+      out.push_back('-');
+    }
+    out.push_back(HEX_DIGITS[bytes[i] >> 4]);
+    out.push_back(HEX_DIGITS[bytes[i] & 0x0F]);
+  }
+  return out;
+}
+
+std::string FormatBytea(const unsigned char* bytes, size_t size) {
+  std::string out;
+  out.reserve(2 + size * 2);
+  out.append("\\x");
+  for (size_t i = 0; i < size; i++) {
+    out.push_back(HEX_DIGITS[bytes[i] >> 4]);
+    out.push_back(HEX_DIGITS[bytes[i] & 0x0F]);
+  }
+  return out;
+}
+
+std::string FormatArray(const std::vector<int16_t>& values) {
+  return FormatNumericArray(values);
+}
+
+std::string FormatArray(const std::vector<int32_t>& values) {
+  return FormatNumericArray(values);
+}
+
+std::string FormatArray(const std::vector<int64_t>& values) {
+  return FormatNumericArray(values);
+}
+
+std::string FormatArray(const std::vector<float>& values) {
+  return FormatNumericArray(values);
+}
+
+std::string FormatArray(const std::vector<double>& values) {
+  return FormatNumericArray(values);
+}
+
+std::string FormatArray(const std::vector<std::string>& values) {
+  std::string out;
+  out.push_back('{');
+  for (size_t i = 0; i < values.size(); i++) {
+    if (i > 0) {
+      out.push_back(',');
+    }
+    AppendQuoted(out, values[i]);
+  }
+  out.push_back('}');
+  return out;
+}
+
+std::vector<std::string> ParseArray(std::string_view value) {
+  if (value.size() < 2 || value.front() != '{' || value.back() != '}') {
+    throw std::invalid_argument("Malformed array [" + std::string(value) +
+                                "]");
+  }
+
+  std::vector<std::string> elements;
+  if (value.size() == 2) {
+    return elements;
+  }
+
+  size_t pos = 1;
+  auto end = value.size() - 1;
+  while (true) {
+    std::string element;
+    if (value[pos] == '{') {
+      throw std::invalid_argument("Multi-dimensional array is not supported");
+    } else if (value[pos] == '"') {
+      pos++;
+      while (pos < end && value[pos] != '"') {
+        if (value[pos] == '\\' && pos + 1 < end) {
+          pos++;
+        }
+        element.push_back(value[pos++]);
+      }
+      if (pos >= end) {
+        throw std::invalid_argument("Malformed array, unterminated quote");
+      }
+      pos++;
+    } else {
+      auto next = value.find(',', pos);
+      next = next == std::string_view::npos || next > end ? end : next;
+      element.assign(value.substr(pos, next - pos));
+      if (IsNullLiteral(element)) {
+        throw std::invalid_argument("Array has null element");
+      }
+      pos = next;
+    }
+
+    elements.emplace_back(std::move(element));
+    if (pos == end) {
+      return elements;
+    }
+    if (value[pos] != ',') {
+      throw std::invalid_argument("Malformed array [" + std::string(value) +
+                                  "]");
+    }
+    pos++;
+  }
+}
+
+NVSERV_END_NAMESPACE
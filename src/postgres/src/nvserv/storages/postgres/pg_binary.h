@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nvserv/global_macro.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages::postgres::helper)
+
+/// @brief Postgres built-in type OIDs used by the binary format.
+namespace oid {
+constexpr uint32_t BOOL = 16;
+constexpr uint32_t BYTEA = 17;
+constexpr uint32_t NAME = 19;
+constexpr uint32_t INT8 = 20;
+constexpr uint32_t INT2 = 21;
+constexpr uint32_t INT4 = 23;
+constexpr uint32_t TEXT = 25;
+constexpr uint32_t JSON = 114;
+constexpr uint32_t XML = 142;
+constexpr uint32_t FLOAT4 = 700;
+constexpr uint32_t FLOAT8 = 701;
+constexpr uint32_t BPCHAR = 1042;
+constexpr uint32_t VARCHAR = 1043;
+constexpr uint32_t DATE = 1082;
+constexpr uint32_t TIME = 1083;
+constexpr uint32_t TIMESTAMP = 1114;
+constexpr uint32_t TIMESTAMPTZ = 1184;
+constexpr uint32_t UUID = 2950;
+constexpr uint32_t JSONB = 3802;
+constexpr uint32_t INT2_ARRAY = 1005;
+constexpr uint32_t INT4_ARRAY = 1007;
+constexpr uint32_t TEXT_ARRAY = 1009;
+constexpr uint32_t BPCHAR_ARRAY = 1014;
+constexpr uint32_t VARCHAR_ARRAY = 1015;
+constexpr uint32_t INT8_ARRAY = 1016;
+constexpr uint32_t FLOAT4_ARRAY = 1021;
+constexpr uint32_t FLOAT8_ARRAY = 1022;
+}  // namespace oid
+
+/// Binary (send/recv) representation, big-endian.
+/// Timestamps are microseconds since 2000-01-01 00:00:00 UTC.
+
+/// @brief 'infinity' and '-infinity' timestamps as unix microseconds,
+/// the same values the binary format sends.
+constexpr int64_t TIMESTAMP_INFINITY = std::numeric_limits<int64_t>::max();
+constexpr int64_t TIMESTAMP_NEGATIVE_INFINITY =
+    std::numeric_limits<int64_t>::min();
+
+std::string WriteInt16(int16_t value);
+
+std::string WriteInt32(int32_t value);
+
+std::string WriteInt64(int64_t value);
+
+std::string WriteFloat4(float value);
+
+std::string WriteFloat8(double value);
+
+std::string WriteBool(bool value);
+
+/// @brief time_point::max()/min() are sent as 'infinity'/'-infinity'.
+std::string WriteTimestamp(
+    const std::chrono::system_clock::time_point& value);
+
+/// @brief One-dimensional array without null elements,
+/// lower bound 1. Strings are sent as text[].
+std::string WriteArray(const std::vector<int16_t>& values);
+
+std::string WriteArray(const std::vector<int32_t>& values);
+
+std::string WriteArray(const std::vector<int64_t>& values);
+
+std::string WriteArray(const std::vector<float>& values);
+
+std::string WriteArray(const std::vector<double>& values);
+
+std::string WriteArray(const std::vector<std::string>& values);
+
+/// @brief Element type of array type OID, 0 when it is not an array NvQL
+/// decodes.
+uint32_t ArrayElementType(uint32_t array_type);
+
+/// @brief Elements of one-dimensional array as views into value,
+/// decoded further with the element type. Throws std::invalid_argument on
+/// multi-dimensional arrays and null elements.
+std::vector<std::string_view> ReadArray(std::string_view value,
+                                        uint32_t& element_type);
+
+/// @brief Integer column of any width (int2, int4, int8).
+int64_t ReadInteger(std::string_view value, uint32_t type);
+
+/// @brief Floating point or integer column.
+double ReadFloat(std::string_view value, uint32_t type);
+
+/// @brief Non-throwing ReadInteger, false on non-integer type or size.
+bool TryReadInteger(std::string_view value, uint32_t type, int64_t& result);
+
+/// @brief Non-throwing ReadFloat, false on non-numeric type or size.
+bool TryReadFloat(std::string_view value, uint32_t type, double& result);
+
+bool ReadBool(std::string_view value);
+
+/// @brief See MicrosToTimePoint() for infinity and the clock range.
+std::chrono::system_clock::time_point ReadTimestamp(
+    std::string_view value);
+
+/// @brief Timestamp as unix microseconds UTC, infinity is kept as
+/// TIMESTAMP_INFINITY/TIMESTAMP_NEGATIVE_INFINITY.
+int64_t ReadTimestampMicros(std::string_view value);
+
+/// @brief Unix microseconds as time_point, infinity saturates to
+/// time_point::max()/min(). system_clock may not cover the whole
+/// Postgres range (BC dates with nanosecond clocks), finite values beyond
+/// it throw std::out_of_range.
+std::chrono::system_clock::time_point MicrosToTimePoint(int64_t micros);
+
+/// @brief Text representation of binary value, as the text format would
+/// return it. Throws std::invalid_argument on types without conversion.
+std::string ReadAsText(std::string_view value, uint32_t type);
+
+std::string FormatUuid(const unsigned char* bytes);
+
+/// @brief Bytea text representation ("\x" hex).
+std::string FormatBytea(const unsigned char* bytes, size_t size);
+
+/// @brief Array text representation ("{1,2}"), strings are always quoted.
+std::string FormatArray(const std::vector<int16_t>& values);
+
+std::string FormatArray(const std::vector<int32_t>& values);
+
+std::string FormatArray(const std::vector<int64_t>& values);
+
+std::string FormatArray(const std::vector<float>& values);
+
+std::string FormatArray(const std::vector<double>& values);
+
+std::string FormatArray(const std::vector<std::string>& values);
+
+/// @brief Elements of one-dimensional text array ("{1,2}", "{a,\"b c\"}"),
+/// unquoted & unescaped. Throws std::invalid_argument on malformed or
+/// multi-dimensional arrays and null elements.
+std::vector<std::string> ParseArray(std::string_view value);
+
+NVSERV_END_NAMESPACE
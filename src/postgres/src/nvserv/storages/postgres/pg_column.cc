@@ -23,10 +23,12 @@
 
 NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
- PgColumn::PgColumn(const pqxx::field& field) : field_(field) {}
+ PgColumn::PgColumn(const pqxx::field& field) : name_(field.name()) {}
+
+ PgColumn::PgColumn(const std::string& name) : name_(name) {}
 
   std::string PgColumn::Name() const  {
-    return field_.name();
+    return name_;
   }
 
 NVSERV_END_NAMESPACE
\ No newline at end of file
@@ -32,11 +32,13 @@ class PgColumn : public Column {
  public:
   explicit PgColumn(const pqxx::field& field) ;
 
+  explicit PgColumn(const std::string& name);
+
   std::string Name() const override;
 
  protected:
  private:
-  pqxx::field field_;
+  std::string name_;
 };
 
 NVSERV_END_NAMESPACE
\ No newline at end of file
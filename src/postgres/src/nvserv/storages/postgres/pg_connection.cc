@@ -20,6 +20,8 @@
  */
 #include "nvserv/storages/postgres/pg_connection.h"
 
+#include "nvserv/storages/postgres/pg_pipeline.h"
+
 NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
 PgConnection::PgConnection(const std::string& name,
@@ -31,6 +33,7 @@ PgConnection::PgConnection(const std::string& name,
                   clusters_(clusters),
                   connection_string_(BuildConnectionString()),
                   conn_(nullptr),
+                  raw_conn_(nullptr),
                   mode_(),
                   hash_key_(CreateHashKey()) {}
 
@@ -70,7 +73,7 @@ bool PgConnection::PingServer() {
 
 TransactionMode PgConnection::SupportedTransactionMode() const {
   return TransactionMode::ReadCommitted | TransactionMode::ReadOnly |
-         TransactionMode::ReadWrite;
+         TransactionMode::ReadWrite | TransactionMode::AutoCommit;
 }
 
 void PgConnection::ReportHealth() const {
@@ -93,20 +96,69 @@ const std::string& PgConnection::GetConnectionString() const {
   return connection_string_;
 };
 
-std::optional<std::pair<std::string, bool>> PgConnection::PrepareStatement(
+std::optional<PreparedStatementKey> PgConnection::PrepareStatement(
     __NR_STRING_COMPAT_REF query) {
   if (!prepared_statement_manager_) {
     throw NullReferenceException("Null reference to PrepareStatemenManagerPtr "
                                  "in prepared_statement_manager_");
   }
 
-  return std::move(prepared_statement_manager_->Register(query));
+  return prepared_statement_manager_->Register(query);
 }
 
 pqxx::connection* PgConnection::Driver() {
   return conn_.get();
 }
 
+PGconn* PgConnection::RawHandle() {
+  return raw_conn_;
+}
+
+PgParamBuffer& PgConnection::ParamBuffer() {
+  return param_buffer_;
+}
+
+void PgConnection::PreparedStatementFailed(StatementId id,
+                                           const std::string& sqlstate,
+                                           bool prepare_failed) {
+  if (sqlstate == impl::PG_STALE_PLAN) {
+    // DEALLOCATE & PREPARE again on the next use
+    prepared_statement_manager_->MarkStale(id);
+    return;
+  }
+
+  // Rejected PREPARE, unless the name is already prepared on the server.
+  // Missing on execution, e.g. DEALLOCATE ALL from outside.
+  if ((prepare_failed && sqlstate != impl::PG_DUPLICATE_PREPARED) ||
+      sqlstate == impl::PG_UNKNOWN_PREPARED) {
+    prepared_statement_manager_->Forget(id);
+  }
+}
+
+void PgConnection::DeallocateFailed(StatementId id,
+                                    const std::string& sqlstate) {
+  // Already gone is what DEALLOCATE was after
+  if (sqlstate != impl::PG_UNKNOWN_PREPARED) {
+    prepared_statement_manager_->Restore(id);
+  }
+}
+
+QueryDeadline::CancelCallback PgConnection::CancelCallback() {
+  if (!raw_conn_) {
+    return nullptr;
+  }
+
+  auto cancel = std::shared_ptr<PGcancel>(PQgetCancel(raw_conn_), PQfreeCancel);
+  if (!cancel) {
+    return nullptr;
+  }
+
+  return [cancel]() {
+    char error[256];
+    PQcancel(cancel.get(), error, sizeof(error));
+  };
+}
+
 // protected
 
 void PgConnection::OpenImpl() {
@@ -118,7 +170,37 @@ void PgConnection::OpenImpl() {
   try {
     // std::cout << "Connection string:" << connection_string_ << std::endl;
 
-    conn_ = std::make_unique<pqxx::connection>(connection_string_);
+    // Connect through libpq and let pqxx seize the handle,
+    // so we still have the raw handle for libpq direct access.
+    auto raw_conn = PQconnectdb(connection_string_.c_str());
+    if (PQstatus(raw_conn) != CONNECTION_OK) {
+      std::string error = raw_conn ? PQerrorMessage(raw_conn)
+                                   : "Out of memory on PQconnectdb";
+      PQfinish(raw_conn);
+      throw pqxx::broken_connection(error);
+    }
+
+    conn_ = std::make_unique<pqxx::connection>(
+        pqxx::connection::seize_raw_connection(raw_conn));
+    raw_conn_ = raw_conn;
+
+    // New session, nothing is prepared on the server yet
+    prepared_statement_manager_->Reset();
+    try {
+      Warmup();
+    } catch (const std::exception&) {
+      // Warm-up is best effort, start clean and prepare on first use
+      prepared_statement_manager_->Reset();
+      auto result = PQexec(raw_conn_, "DEALLOCATE ALL");
+      bool clean = result && PQresultStatus(result) == PGRES_COMMAND_OK;
+      PQclear(result);
+      if (!clean) {
+        // Not left half-open, the next Open starts over
+        conn_.reset();
+        raw_conn_ = nullptr;
+        throw;
+      }
+    }
 
   } catch (const pqxx::broken_connection& e) {
     throw ConnectionException(e.what(), StorageType::Postgres);
@@ -135,6 +217,44 @@ void PgConnection::OpenImpl() {
   }
 }
 
+void PgConnection::Warmup() {
+  const auto& catalog = prepared_statement_manager_->Catalog();
+  auto manifest = catalog->Warmup();
+  if (manifest.empty()) {
+    return;
+  }
+
+  // Beyond the capacity the manifest would only evict itself
+  auto capacity = prepared_statement_manager_->Capacity();
+  if (capacity > 0 && manifest.size() > capacity) {
+    manifest.resize(capacity);
+  }
+
+  PgPipeline pipeline(raw_conn_);
+  for (auto& warmup : manifest) {
+    auto key = prepared_statement_manager_->Register(warmup.id);
+
+    PgAsyncStatement statement;
+    statement.name = key.Name();
+    statement.query = catalog->Query(warmup.id);
+    statement.prepare = true;
+    statement.execute = false;
+    // Recorded so every later execution encodes against these types
+    statement.param_types =
+        catalog->RecordParamTypes(warmup.id, std::move(warmup.param_types));
+    pipeline.Add(std::move(statement));
+  }
+
+  // Isolated, one broken statement must not skip the others
+  auto results = pipeline.Run(true);
+  for (size_t i = 0; i < results.size(); i++) {
+    if (!results[i].Ok()) {
+      // Prepared lazily on first use, which reports the error
+      prepared_statement_manager_->Forget(manifest[i].id);
+    }
+  }
+}
+
 void PgConnection::CloseImpl() {
   if (!conn_) {
     return;
@@ -145,6 +265,7 @@ void PgConnection::CloseImpl() {
 
   try {
     // Explicitly close the connection
+    raw_conn_ = nullptr;
     conn_->close();
     std::cout << "Connection to database closed successfully." << "\n";
   } catch (const pqxx::broken_connection& e) {
@@ -164,6 +285,7 @@ void PgConnection::ReleaseImpl() {
 
   Close();
   conn_ = nullptr;
+  raw_conn_ = nullptr;
 }
 
 // private
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <libpq-fe.h>
+
 #include <exception>
 #include <memory>
 #include <pqxx/pqxx>
@@ -30,9 +32,24 @@
 #include "nvserv/storages/connection.h"
 #include "nvserv/storages/exceptions.h"
 #include "nvserv/storages/postgres/pg_cluster_config.h"
+#include "nvserv/storages/postgres/pg_param_buffer.h"
+#include "nvserv/storages/query_watchdog.h"
 
 NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
+namespace impl {
+
+// SQLSTATE feature_not_supported, raised on stale cached plan
+constexpr const char* PG_STALE_PLAN = "0A000";
+// SQLSTATE duplicate_prepared_statement, name already prepared
+constexpr const char* PG_DUPLICATE_PREPARED = "42P05";
+// SQLSTATE invalid_sql_statement_name, no such prepared statement
+constexpr const char* PG_UNKNOWN_PREPARED = "26000";
+// SQLSTATE query_canceled, statement_timeout or a cancel request fired
+constexpr const char* PG_QUERY_CANCELED = "57014";
+
+}  // namespace impl
+
 class PgConnection : public Connection {
  public:
   explicit PgConnection(
@@ -69,11 +86,34 @@ class PgConnection : public Connection {
 
   const std::string& GetConnectionString() const override;
 
-  std::optional<std::pair<std::string, bool>> PrepareStatement(
+  std::optional<PreparedStatementKey> PrepareStatement(
       __NR_STRING_COMPAT_REF query) override;
 
   pqxx::connection* Driver();
 
+  /// @brief Raw libpq handle of the Driver() connection, owned by pqxx.
+  /// Used for libpq direct access (non-blocking reactor etc.),
+  /// never use it concurrently with the pqxx connection.
+  PGconn* RawHandle();
+
+  /// @brief Callback that cancels the statement currently running on this
+  /// connection, safe to call from any thread (used by QueryWatchdog).
+  /// Must be created from the thread that owns the connection.
+  QueryDeadline::CancelCallback CancelCallback();
+
+  /// @brief Parameter encoding buffer reused by every execution
+  /// on this connection.
+  PgParamBuffer& ParamBuffer();
+
+  /// @brief Statement `id` failed with `sqlstate`, `prepare_failed` when
+  /// its PREPARE was rejected. Rolls back what Register recorded up front,
+  /// or marks the plan stale.
+  void PreparedStatementFailed(StatementId id, const std::string& sqlstate,
+                               bool prepare_failed);
+
+  /// @brief DEALLOCATE of the evicted statement `id` failed with `sqlstate`.
+  void DeallocateFailed(StatementId id, const std::string& sqlstate);
+
  protected:
   void OpenImpl() override;
 
@@ -85,13 +125,19 @@ class PgConnection : public Connection {
   ClusterConfigList clusters_;
   std::string connection_string_;
   std::unique_ptr<pqxx::connection> conn_;
+  PGconn* raw_conn_;
   ConnectionMode mode_;
   std::hash<std::string> hash_fn_;
   size_t hash_key_;
+  PgParamBuffer param_buffer_;
 
   size_t CreateHashKey();
 
   std::string BuildConnectionString();
+
+  // Prepare the catalog warm-up manifest in one pipelined batch,
+  // throws only when the connection itself failed
+  void Warmup();
 };
 
 NVSERV_END_NAMESPACE
\ No newline at end of file
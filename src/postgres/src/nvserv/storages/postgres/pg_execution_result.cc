@@ -27,23 +27,27 @@ NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
 PgExecutionResult::PgExecutionResult(pqxx::result&& result)
                 : ExecutionResult(StorageType::Postgres),
-                  result_(std::forward<pqxx::result>(result)) {}
+                  result_(std::make_shared<const PgResultSet>(
+                      std::forward<pqxx::result>(result))) {}
+
+PgExecutionResult::PgExecutionResult(PgResultSetPtr result)
+                : ExecutionResult(StorageType::Postgres),
+                  result_(std::move(result)) {}
 
 bool PgExecutionResult::Empty() const {
-  return result_.empty();
+  return result_->Empty();
 }
 
 size_t PgExecutionResult::RowAffected() const {
-  return result_.affected_rows();
+  return result_->AffectedRows();
 }
 
 RowResultPtr PgExecutionResult::At(const int& offset) const {
-  if (offset < 0 || offset >= result_.size()) {
+  if (offset < 0 || offset >= result_->Rows()) {
     throw nvserv::OutOfBoundException("`At`offset out of range [" +
                                       std::to_string(offset) + "]");
   }
-  return std::move(std::make_shared<PgRowResult>(
-      std::make_shared<pqxx::row>(result_.at(offset))));
+  return std::move(std::make_shared<PgRowResult>(result_, offset));
 }
 
 std::unique_ptr<RowResultIterator> PgExecutionResult::begin() const {
@@ -51,7 +55,167 @@ std::unique_ptr<RowResultIterator> PgExecutionResult::begin() const {
 }
 
 std::unique_ptr<RowResultIterator> PgExecutionResult::end() const {
-  return std::make_unique<PgRowResultIterator>(result_, result_.size());
+  return std::make_unique<PgRowResultIterator>(result_, result_->Rows());
+}
+
+const PgResultSetPtr& PgExecutionResult::ResultSet() const {
+  return result_;
+}
+
+int PgExecutionResult::RowCount() const {
+  return result_->Rows();
+}
+
+// protected:
+
+int PgExecutionResult::ColumnCount() const {
+  return result_->Columns();
+}
+
+int PgExecutionResult::ColumnIndex(const std::string& column_name) const {
+  return PgFieldReader::ColumnIndex(*result_, column_name);
+}
+
+std::string PgExecutionResult::ColumnName(const int& index) const {
+  if (index < 0 || index >= result_->Columns()) {
+    throw std::invalid_argument("Column index is out-of-bounds [" +
+                                std::to_string(index) + "]");
+  }
+  return result_->ColumnName(index);
+}
+
+std::optional<parameters::DataType> PgExecutionResult::ColumnType(
+    const int& index) const {
+  return PgFieldReader::ColumnDataType(*result_, index);
+}
+
+int16_t PgExecutionResult::AsImpl_int16_t(const int& row,
+                                          const int& index) const {
+  return PgFieldReader::Int16(*result_, row, index);
+}
+
+int32_t PgExecutionResult::AsImpl_int32_t(const int& row,
+                                          const int& index) const {
+  return PgFieldReader::Int32(*result_, row, index);
+}
+
+int64_t PgExecutionResult::AsImpl_int64_t(const int& row,
+                                          const int& index) const {
+  return PgFieldReader::Int64(*result_, row, index);
+}
+
+std::string PgExecutionResult::AsImpl_string(const int& row,
+                                             const int& index) const {
+  return PgFieldReader::String(*result_, row, index);
+}
+
+float PgExecutionResult::AsImpl_float(const int& row, const int& index) const {
+  return PgFieldReader::Float(*result_, row, index);
+}
+
+double PgExecutionResult::AsImpl_double(const int& row,
+                                        const int& index) const {
+  return PgFieldReader::Double(*result_, row, index);
+}
+
+nvm::dates::DateTime PgExecutionResult::AsImpl_DateTime_Timestampz(
+    const int& row, const int& index) const {
+  return PgFieldReader::Timestampz(*result_, row, index);
+}
+
+nvm::dates::DateTime PgExecutionResult::AsImpl_DateTime_Timestamp(
+    const int& row, const int& index) const {
+  return PgFieldReader::Timestamp(*result_, row, index);
+}
+
+std::string_view PgExecutionResult::AsImpl_string_view(
+    const int& row, const int& index) const {
+  return PgFieldReader::StringView(*result_, row, index);
+}
+
+BytesView PgExecutionResult::AsImpl_bytes(const int& row,
+                                          const int& index) const {
+  return PgFieldReader::Bytes(*result_, row, index);
+}
+
+std::vector<int16_t> PgExecutionResult::AsImpl_vector_int16_t(
+    const int& row, const int& index) const {
+  return PgFieldReader::Array<int16_t>(*result_, row, index);
+}
+
+std::vector<int32_t> PgExecutionResult::AsImpl_vector_int32_t(
+    const int& row, const int& index) const {
+  return PgFieldReader::Array<int32_t>(*result_, row, index);
+}
+
+std::vector<int64_t> PgExecutionResult::AsImpl_vector_int64_t(
+    const int& row, const int& index) const {
+  return PgFieldReader::Array<int64_t>(*result_, row, index);
+}
+
+std::vector<float> PgExecutionResult::AsImpl_vector_float(
+    const int& row, const int& index) const {
+  return PgFieldReader::Array<float>(*result_, row, index);
+}
+
+std::vector<double> PgExecutionResult::AsImpl_vector_double(
+    const int& row, const int& index) const {
+  return PgFieldReader::Array<double>(*result_, row, index);
+}
+
+std::vector<std::string> PgExecutionResult::AsImpl_vector_string(
+    const int& row, const int& index) const {
+  return PgFieldReader::Array<std::string>(*result_, row, index);
+}
+
+void PgExecutionResult::DecodeColumn(const int& index, const int& begin,
+                                     const int& end,
+                                     ColumnVector& column) const {
+  PgFieldReader::DecodeColumn(*result_, index, begin, end, column);
+}
+
+bool PgExecutionResult::IsNull(const int& row, const int& index) const {
+  return PgFieldReader::IsNull(*result_, row, index);
+}
+
+int PgExecutionResult::FindColumnIndex(const std::string& column_name) const {
+  return result_->ColumnNumber(column_name);
+}
+
+FieldStatus PgExecutionResult::TryAsImpl_int16_t(const int& row,
+                                                 const int& index,
+                                                 int16_t& value) const {
+  return PgFieldReader::TryInt16(*result_, row, index, value);
+}
+
+FieldStatus PgExecutionResult::TryAsImpl_int32_t(const int& row,
+                                                 const int& index,
+                                                 int32_t& value) const {
+  return PgFieldReader::TryInt32(*result_, row, index, value);
+}
+
+FieldStatus PgExecutionResult::TryAsImpl_int64_t(const int& row,
+                                                 const int& index,
+                                                 int64_t& value) const {
+  return PgFieldReader::TryInt64(*result_, row, index, value);
+}
+
+FieldStatus PgExecutionResult::TryAsImpl_string(const int& row,
+                                                const int& index,
+                                                std::string& value) const {
+  return PgFieldReader::TryString(*result_, row, index, value);
+}
+
+FieldStatus PgExecutionResult::TryAsImpl_float(const int& row,
+                                               const int& index,
+                                               float& value) const {
+  return PgFieldReader::TryFloat(*result_, row, index, value);
+}
+
+FieldStatus PgExecutionResult::TryAsImpl_double(const int& row,
+                                                const int& index,
+                                                double& value) const {
+  return PgFieldReader::TryDouble(*result_, row, index, value);
 }
 
-NVSERV_END_NAMESPACE
\ No newline at end of file
+NVSERV_END_NAMESPACE
@@ -25,15 +25,19 @@
 #include "nvserv/global_macro.h"
 #include "nvserv/storages/declare.h"
 #include "nvserv/storages/execution_result.h"
+#include "nvserv/storages/postgres/pg_field_reader.h"
+#include "nvserv/storages/postgres/pg_result_set.h"
 #include "nvserv/storages/postgres/pg_row_result.h"
 #include "nvserv/storages/postgres/pg_row_result_iterator.h"
 
 NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
-class PgExecutionResult : public ExecutionResult {
+class PgExecutionResult final : public ExecutionResult {
  public:
   explicit PgExecutionResult(pqxx::result&& result);
 
+  explicit PgExecutionResult(PgResultSetPtr result);
+
   bool Empty() const override;
 
   size_t RowAffected() const override;
@@ -44,8 +48,88 @@ class PgExecutionResult : public ExecutionResult {
 
   std::unique_ptr<RowResultIterator> end() const override;
 
+  const PgResultSetPtr& ResultSet() const;
+
+  int RowCount() const override;
+
+  int ColumnCount() const override;
+
+  int ColumnIndex(const std::string& column_name) const override;
+
+  std::string ColumnName(const int& index) const override;
+
+  std::optional<parameters::DataType> ColumnType(
+      const int& index) const override;
+
+ protected:
+  int16_t AsImpl_int16_t(const int& row, const int& index) const override;
+
+  int32_t AsImpl_int32_t(const int& row, const int& index) const override;
+
+  int64_t AsImpl_int64_t(const int& row, const int& index) const override;
+
+  std::string AsImpl_string(const int& row, const int& index) const override;
+
+  float AsImpl_float(const int& row, const int& index) const override;
+
+  double AsImpl_double(const int& row, const int& index) const override;
+
+  nvm::dates::DateTime AsImpl_DateTime_Timestampz(
+      const int& row, const int& index) const override;
+
+  nvm::dates::DateTime AsImpl_DateTime_Timestamp(
+      const int& row, const int& index) const override;
+
+  std::string_view AsImpl_string_view(const int& row,
+                                      const int& index) const override;
+
+  BytesView AsImpl_bytes(const int& row, const int& index) const override;
+
+  std::vector<int16_t> AsImpl_vector_int16_t(const int& row,
+                                             const int& index) const override;
+
+  std::vector<int32_t> AsImpl_vector_int32_t(const int& row,
+                                             const int& index) const override;
+
+  std::vector<int64_t> AsImpl_vector_int64_t(const int& row,
+                                             const int& index) const override;
+
+  std::vector<float> AsImpl_vector_float(const int& row,
+                                         const int& index) const override;
+
+  std::vector<double> AsImpl_vector_double(const int& row,
+                                           const int& index) const override;
+
+  std::vector<std::string> AsImpl_vector_string(
+      const int& row, const int& index) const override;
+
+  void DecodeColumn(const int& index, const int& begin, const int& end,
+                    ColumnVector& column) const override;
+
+  bool IsNull(const int& row, const int& index) const override;
+
+  int FindColumnIndex(const std::string& column_name) const override;
+
+  FieldStatus TryAsImpl_int16_t(const int& row, const int& index,
+                                int16_t& value) const override;
+
+  FieldStatus TryAsImpl_int32_t(const int& row, const int& index,
+                                int32_t& value) const override;
+
+  FieldStatus TryAsImpl_int64_t(const int& row, const int& index,
+                                int64_t& value) const override;
+
+  FieldStatus TryAsImpl_string(const int& row, const int& index,
+                               std::string& value) const override;
+
+  FieldStatus TryAsImpl_float(const int& row, const int& index,
+                              float& value) const override;
+
+  FieldStatus TryAsImpl_double(const int& row, const int& index,
+                               double& value) const override;
+
  private:
-  pqxx::result result_;
+  PgResultSetPtr result_;
 };
 
 NVSERV_END_NAMESPACE
\ No newline at end of file
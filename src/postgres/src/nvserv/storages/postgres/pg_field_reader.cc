@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_field_reader.h"
+
+#include <charconv>
+#include <limits>
+#include <pqxx/pqxx>
+#include <stdexcept>
+#include <type_traits>
+
+#include "nvserv/storages/postgres/pg_binary.h"
+#include "nvserv/storages/postgres/pg_helper.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+namespace {
+
+template <typename T>
+T DecodeArrayElement(std::string_view value, uint32_t type) {
+  if constexpr (is_type_v<T, std::string>) {
+    return helper::ReadAsText(value, type);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return static_cast<T>(helper::ReadFloat(value, type));
+  } else {
+    auto decoded = helper::ReadInteger(value, type);
+    if (decoded < std::numeric_limits<T>::min() ||
+        decoded > std::numeric_limits<T>::max()) {
+      throw std::out_of_range("Array element is out of range");
+    }
+    return static_cast<T>(decoded);
+  }
+}
+
+}  // namespace
+
+// static
+std::string PgFieldReader::String(const PgResultSet& result, int row,
+                                  int column) {
+  return Guard([&]() {
+    auto value = Value(result, row, column);
+    if (IsBinary(result, column)) {
+      return helper::ReadAsText(value, result.ColumnType(column));
+    }
+    return std::string(value);
+  });
+}
+
+// static
+template <typename T>
+std::vector<T> PgFieldReader::Array(const PgResultSet& result, int row,
+                                    int column) {
+  return Guard([&]() {
+    auto value = Value(result, row, column);
+    if (helper::ArrayElementType(result.ColumnType(column)) == 0) {
+      throw std::invalid_argument("Column [" + result.ColumnName(column) +
+                                  "] is not a supported array");
+    }
+
+    std::vector<T> values;
+    if (!IsBinary(result, column)) {
+      auto elements = helper::ParseArray(value);
+      values.reserve(elements.size());
+      for (auto& element : elements) {
+        if constexpr (is_type_v<T, std::string>) {
+          values.emplace_back(std::move(element));
+        } else {
+          values.push_back(pqxx::from_string<T>(element));
+        }
+      }
+      return values;
+    }
+
+    uint32_t element_type;
+    auto elements = helper::ReadArray(value, element_type);
+    values.reserve(elements.size());
+    for (auto element : elements) {
+      values.push_back(DecodeArrayElement<T>(element, element_type));
+    }
+    return values;
+  });
+}
+
+template std::vector<int16_t> PgFieldReader::Array<int16_t>(
+    const PgResultSet& result, int row, int column);
+template std::vector<int32_t> PgFieldReader::Array<int32_t>(
+    const PgResultSet& result, int row, int column);
+template std::vector<int64_t> PgFieldReader::Array<int64_t>(
+    const PgResultSet& result, int row, int column);
+template std::vector<float> PgFieldReader::Array<float>(
+    const PgResultSet& result, int row, int column);
+template std::vector<double> PgFieldReader::Array<double>(
+    const PgResultSet& result, int row, int column);
+template std::vector<std::string> PgFieldReader::Array<std::string>(
+    const PgResultSet& result, int row, int column);
+
+// static
+nvm::dates::DateTime PgFieldReader::Timestampz(const PgResultSet& result,
+                                               int row, int column) {
+  return Guard([&]() {
+    auto time_point = DecodeTimestamp(result, row, column, true);
+    return helper::ToUtcDateTime(time_point);
+  });
+}
+
+// static
+nvm::dates::DateTime PgFieldReader::Timestamp(const PgResultSet& result,
+                                              int row, int column) {
+  return Guard([&]() {
+    auto time_point = DecodeTimestamp(result, row, column, false);
+    return helper::ToUtcDateTime(time_point);
+  });
+}
+
+// static
+FieldStatus PgFieldReader::TryString(const PgResultSet& result, int row,
+                                     int column, std::string& value) {
+  std::string_view raw;
+  auto status = TryValue(result, row, column, raw);
+  if (status != FieldStatus::Ok) {
+    return status;
+  }
+
+  if (!IsBinary(result, column)) {
+    value.assign(raw.data(), raw.size());
+    return FieldStatus::Ok;
+  }
+
+  // Only binary types without text conversion throw, not the hot path
+  try {
+    value = helper::ReadAsText(raw, result.ColumnType(column));
+  } catch (const std::invalid_argument&) {
+    return FieldStatus::Invalid;
+  }
+  return FieldStatus::Ok;
+}
+
+// static
+void PgFieldReader::DecodeColumn(const PgResultSet& result, int column,
+                                 int begin, int end, ColumnVector& out) {
+  if (column < 0 || column >= result.Columns()) {
+    throw std::invalid_argument("Column index is out-of-bounds [" +
+                                std::to_string(column) + "]");
+  }
+  if (begin < 0 || end > result.Rows() || begin > end) {
+    throw std::invalid_argument("Row range is out-of-bounds [" +
+                                std::to_string(begin) + ", " +
+                                std::to_string(end) + ")");
+  }
+
+  auto binary = IsBinary(result, column);
+  auto type = result.ColumnType(column);
+
+  size_t data_bytes = 0;
+  if (out.Kind() == ColumnKind::String) {
+    for (int row = begin; row < end; row++) {
+      if (!result.IsNull(row, column)) {
+        data_bytes += result.Value(row, column).size();
+      }
+    }
+  }
+  out.Reserve(static_cast<size_t>(end - begin), data_bytes);
+
+  auto invalid = [&](int row) {
+    return std::invalid_argument(
+        "Column [" + result.ColumnName(column) + "] row [" +
+        std::to_string(row) + "] can't be decoded as the column kind");
+  };
+
+  switch (out.Kind()) {
+    case ColumnKind::Int64:
+      for (int row = begin; row < end; row++) {
+        if (result.IsNull(row, column)) {
+          out.AppendNull();
+          continue;
+        }
+        int64_t value;
+        auto raw = result.Value(row, column);
+        if (binary) {
+          if (!helper::TryReadInteger(raw, type, value)) {
+            throw invalid(row);
+          }
+        } else {
+          auto end = raw.data() + raw.size();
+          auto [ptr, ec] = std::from_chars(raw.data(), end, value);
+          if (ec != std::errc() || ptr != end) {
+            throw invalid(row);
+          }
+        }
+        out.AppendInt64(value);
+      }
+      break;
+    case ColumnKind::Double:
+      for (int row = begin; row < end; row++) {
+        if (result.IsNull(row, column)) {
+          out.AppendNull();
+          continue;
+        }
+        double value;
+        auto raw = result.Value(row, column);
+        if (binary) {
+          if (!helper::TryReadFloat(raw, type, value)) {
+            throw invalid(row);
+          }
+        } else {
+          auto end = raw.data() + raw.size();
+          auto [ptr, ec] = std::from_chars(raw.data(), end, value);
+          if (ec != std::errc() || ptr != end) {
+            throw invalid(row);
+          }
+        }
+        out.AppendDouble(value);
+      }
+      break;
+    case ColumnKind::Timestamp:
+      for (int row = begin; row < end; row++) {
+        if (result.IsNull(row, column)) {
+          out.AppendNull();
+          continue;
+        }
+        auto raw = result.Value(row, column);
+        out.AppendInt64(binary ? helper::ReadTimestampMicros(raw)
+                               : helper::ParseTimestampMicros(raw));
+      }
+      break;
+    case ColumnKind::String:
+      for (int row = begin; row < end; row++) {
+        if (result.IsNull(row, column)) {
+          out.AppendNull();
+          continue;
+        }
+        auto raw = result.Value(row, column);
+        if (binary) {
+          out.AppendString(helper::ReadAsText(raw, type));
+        } else {
+          out.AppendString(raw);
+        }
+      }
+      break;
+  }
+}
+
+// static
+int PgFieldReader::ColumnIndex(const PgResultSet& result,
+                               const std::string& column_name) {
+  auto index = result.ColumnNumber(column_name);
+  if (index < 0) {
+    throw std::invalid_argument("Unknown column [" + column_name + "]");
+  }
+  return index;
+}
+
+// static
+std::optional<parameters::DataType> PgFieldReader::ColumnDataType(
+    const PgResultSet& result, int column) {
+  if (column < 0 || column >= result.Columns()) {
+    throw std::invalid_argument("Column index is out-of-bounds [" +
+                                std::to_string(column) + "]");
+  }
+
+  using parameters::DataType;
+  switch (result.ColumnType(column)) {
+    case helper::oid::INT2:
+      return DataType::SmallInt;
+    case helper::oid::INT4:
+      return DataType::Int;
+    case helper::oid::INT8:
+      return DataType::BigInt;
+    case helper::oid::FLOAT4:
+      return DataType::Real;
+    case helper::oid::FLOAT8:
+      return DataType::Double;
+    case helper::oid::TEXT:
+    case helper::oid::VARCHAR:
+    case helper::oid::BPCHAR:
+    case helper::oid::NAME:
+      return DataType::String;
+    case helper::oid::BOOL:
+      return DataType::Boolean;
+    case helper::oid::DATE:
+      return DataType::Date;
+    case helper::oid::TIME:
+      return DataType::Time;
+    case helper::oid::TIMESTAMP:
+      return DataType::Timestamp;
+    case helper::oid::TIMESTAMPTZ:
+      return DataType::Timestampz;
+    case helper::oid::BYTEA:
+      return DataType::Bytea;
+    case helper::oid::UUID:
+      return DataType::Uuid;
+    case helper::oid::INT2_ARRAY:
+      return DataType::SmallIntArray;
+    case helper::oid::INT4_ARRAY:
+      return DataType::IntArray;
+    case helper::oid::INT8_ARRAY:
+      return DataType::BigIntArray;
+    case helper::oid::FLOAT4_ARRAY:
+      return DataType::RealArray;
+    case helper::oid::FLOAT8_ARRAY:
+      return DataType::DoubleArray;
+    case helper::oid::TEXT_ARRAY:
+    case helper::oid::VARCHAR_ARRAY:
+    case helper::oid::BPCHAR_ARRAY:
+      return DataType::StringArray;
+    default:
+      return std::nullopt;
+  }
+}
+
+// private:
+
+// static
+std::chrono::system_clock::time_point PgFieldReader::DecodeTimestamp(
+    const PgResultSet& result, int row, int column, bool with_zone) {
+  auto value = Value(result, row, column);
+  if (!IsBinary(result, column)) {
+    return with_zone ? helper::ParseTimestampz(value)
+                     : helper::ParseTimestamp(value);
+  }
+
+  auto type = result.ColumnType(column);
+  if (type != helper::oid::TIMESTAMP && type != helper::oid::TIMESTAMPTZ) {
+    throw std::invalid_argument("Column [" + result.ColumnName(column) +
+                                "] is not a timestamp");
+  }
+  return helper::ReadTimestamp(value);
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <pqxx/pqxx>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "nvm/dates/datetime.h"
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/bytes_view.h"
+#include "nvserv/storages/column_set.h"
+#include "nvserv/storages/parameters/param.h"
+#include "nvserv/storages/postgres/pg_binary.h"
+#include "nvserv/storages/postgres/pg_result_set.h"
+#include "nvserv/storages/row_result.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+/// @brief Typed field access of PgResultSet, shared by PgRowResult and the
+/// allocation-free row views of PgExecutionResult.
+/// Text and binary columns are both decoded, errors (null, out-of-bounds,
+/// conversion) are thrown as std::invalid_argument,
+/// the Try readers report them as FieldStatus instead.
+/// The scalar readers are defined inline below, so PgRowView loops compile
+/// down to the libpq accessors and the binary decode.
+class PgFieldReader {
+ public:
+  static int16_t Int16(const PgResultSet& result, int row, int column);
+
+  static int32_t Int32(const PgResultSet& result, int row, int column);
+
+  static int64_t Int64(const PgResultSet& result, int row, int column);
+
+  static float Float(const PgResultSet& result, int row, int column);
+
+  static double Double(const PgResultSet& result, int row, int column);
+
+  static std::string String(const PgResultSet& result, int row, int column);
+
+  /// @brief Text field without copy, view into the result set.
+  static std::string_view StringView(const PgResultSet& result, int row,
+                                     int column);
+
+  /// @brief Raw field bytes without copy, view into the result set.
+  static BytesView Bytes(const PgResultSet& result, int row, int column);
+
+  /// @brief One-dimensional array column (int2[] .. float8[], text[]),
+  /// T is int16_t, int32_t, int64_t, float, double or std::string.
+  /// Null elements are not supported.
+  template <typename T>
+  static std::vector<T> Array(const PgResultSet& result, int row,
+                              int column);
+
+  static nvm::dates::DateTime Timestampz(const PgResultSet& result, int row,
+                                         int column);
+
+  static nvm::dates::DateTime Timestamp(const PgResultSet& result, int row,
+                                        int column);
+
+  /// @brief Non-throwing readers, value is only written on FieldStatus::Ok.
+  static FieldStatus TryInt16(const PgResultSet& result, int row, int column,
+                              int16_t& value);
+
+  static FieldStatus TryInt32(const PgResultSet& result, int row, int column,
+                              int32_t& value);
+
+  static FieldStatus TryInt64(const PgResultSet& result, int row, int column,
+                              int64_t& value);
+
+  static FieldStatus TryFloat(const PgResultSet& result, int row, int column,
+                              float& value);
+
+  static FieldStatus TryDouble(const PgResultSet& result, int row, int column,
+                               double& value);
+
+  static FieldStatus TryString(const PgResultSet& result, int row, int column,
+                               std::string& value);
+
+  /// @brief Append rows [begin, end) of the column into the typed array,
+  /// one tight loop per ColumnKind.
+  static void DecodeColumn(const PgResultSet& result, int column, int begin,
+                           int end, ColumnVector& out);
+
+  /// @brief Field is null, throws when the column is out-of-bounds.
+  static bool IsNull(const PgResultSet& result, int row, int column);
+
+  /// @brief Column index by name, throws when the column is not exist.
+  static int ColumnIndex(const PgResultSet& result,
+                         const std::string& column_name);
+
+  /// @brief Raw field bytes, throws on null or out-of-bounds column.
+  static std::string_view Value(const PgResultSet& result, int row,
+                                int column);
+
+  static bool IsBinary(const PgResultSet& result, int column);
+
+  /// @brief Column type mapped from its OID, nullopt for types NvQL doesn't
+  /// map to parameters::DataType.
+  static std::optional<parameters::DataType> ColumnDataType(
+      const PgResultSet& result, int column);
+
+ private:
+  // Keep the error contract of RowResult: std::invalid_argument
+  template <typename TFunc>
+  static auto Guard(TFunc&& func) -> decltype(func());
+
+  template <typename T>
+  static T DecodeInteger(const PgResultSet& result, int row, int column);
+
+  template <typename T>
+  static T DecodeFloat(const PgResultSet& result, int row, int column);
+
+  static std::chrono::system_clock::time_point DecodeTimestamp(
+      const PgResultSet& result, int row, int column, bool with_zone);
+
+  static FieldStatus TryValue(const PgResultSet& result, int row, int column,
+                              std::string_view& value);
+
+  template <typename T>
+  static FieldStatus TryDecodeInteger(const PgResultSet& result, int row,
+                                      int column, T& value);
+
+  template <typename T>
+  static FieldStatus TryDecodeFloat(const PgResultSet& result, int row,
+                                    int column, T& value);
+};
+
+// static
+inline int16_t PgFieldReader::Int16(const PgResultSet& result, int row,
+                                    int column) {
+  return Guard([&]() { return DecodeInteger<int16_t>(result, row, column); });
+}
+
+// static
+inline int32_t PgFieldReader::Int32(const PgResultSet& result, int row,
+                                    int column) {
+  return Guard([&]() { return DecodeInteger<int32_t>(result, row, column); });
+}
+
+// static
+inline int64_t PgFieldReader::Int64(const PgResultSet& result, int row,
+                                    int column) {
+  return Guard([&]() { return DecodeInteger<int64_t>(result, row, column); });
+}
+
+// static
+inline float PgFieldReader::Float(const PgResultSet& result, int row,
+                                  int column) {
+  return Guard([&]() { return DecodeFloat<float>(result, row, column); });
+}
+
+// static
+inline double PgFieldReader::Double(const PgResultSet& result, int row,
+                                    int column) {
+  return Guard([&]() { return DecodeFloat<double>(result, row, column); });
+}
+
+// static
+inline std::string_view PgFieldReader::StringView(const PgResultSet& result,
+                                                  int row, int column) {
+  auto value = Value(result, row, column);
+  if (!IsBinary(result, column)) {
+    return value;
+  }
+
+  switch (result.ColumnType(column)) {
+    case helper::oid::TEXT:
+    case helper::oid::VARCHAR:
+    case helper::oid::BPCHAR:
+    case helper::oid::NAME:
+    case helper::oid::JSON:
+    case helper::oid::XML:
+      return value;
+    case helper::oid::JSONB:
+      // version byte followed by the json text
+      return value.empty() ? value : value.substr(1);
+    default:
+      throw std::invalid_argument("Column [" + result.ColumnName(column) +
+                                  "] has no text in binary format");
+  }
+}
+
+// static
+inline BytesView PgFieldReader::Bytes(const PgResultSet& result, int row,
+                                      int column) {
+  auto value = Value(result, row, column);
+  if (!IsBinary(result, column) &&
+      result.ColumnType(column) == helper::oid::BYTEA) {
+    throw std::invalid_argument("Column [" + result.ColumnName(column) +
+                                "] is hex-encoded bytea, use binary format");
+  }
+  return BytesView(value);
+}
+
+// static
+inline FieldStatus PgFieldReader::TryInt16(const PgResultSet& result, int row,
+                                           int column, int16_t& value) {
+  return TryDecodeInteger(result, row, column, value);
+}
+
+// static
+inline FieldStatus PgFieldReader::TryInt32(const PgResultSet& result, int row,
+                                           int column, int32_t& value) {
+  return TryDecodeInteger(result, row, column, value);
+}
+
+// static
+inline FieldStatus PgFieldReader::TryInt64(const PgResultSet& result, int row,
+                                           int column, int64_t& value) {
+  return TryDecodeInteger(result, row, column, value);
+}
+
+// static
+inline FieldStatus PgFieldReader::TryFloat(const PgResultSet& result, int row,
+                                           int column, float& value) {
+  return TryDecodeFloat(result, row, column, value);
+}
+
+// static
+inline FieldStatus PgFieldReader::TryDouble(const PgResultSet& result, int row,
+                                            int column, double& value) {
+  return TryDecodeFloat(result, row, column, value);
+}
+
+// static
+inline bool PgFieldReader::IsNull(const PgResultSet& result, int row,
+                                  int column) {
+  if (column < 0 || column >= result.Columns()) {
+    throw std::invalid_argument("Column index is out-of-bounds [" +
+                                std::to_string(column) + "]");
+  }
+  return result.IsNull(row, column);
+}
+
+// static
+inline std::string_view PgFieldReader::Value(const PgResultSet& result, int row,
+                                             int column) {
+  if (column < 0 || column >= result.Columns()) {
+    throw std::invalid_argument("Column index is out-of-bounds [" +
+                                std::to_string(column) + "]");
+  }
+
+  if (result.IsNull(row, column)) {
+    throw std::invalid_argument("Null value on column [" +
+                                result.ColumnName(column) + "]");
+  }
+
+  return result.Value(row, column);
+}
+
+// static
+inline bool PgFieldReader::IsBinary(const PgResultSet& result, int column) {
+  return result.ColumnFormat(column) == 1;
+}
+
+// private:
+
+// static
+template <typename TFunc>
+auto PgFieldReader::Guard(TFunc&& func) -> decltype(func()) {
+  try {
+    return func();
+  } catch (const std::invalid_argument&) {
+    throw;
+  } catch (const std::exception& e) {
+    throw std::invalid_argument(e.what());
+  }
+}
+
+// static
+template <typename T>
+T PgFieldReader::DecodeInteger(const PgResultSet& result, int row,
+                               int column) {
+  auto value = Value(result, row, column);
+  if (!IsBinary(result, column)) {
+    return pqxx::from_string<T>(value);
+  }
+
+  auto decoded = helper::ReadInteger(value, result.ColumnType(column));
+  if (decoded < std::numeric_limits<T>::min() ||
+      decoded > std::numeric_limits<T>::max()) {
+    throw std::out_of_range("Value of column [" + result.ColumnName(column) +
+                            "] is out of range");
+  }
+  return static_cast<T>(decoded);
+}
+
+// static
+template <typename T>
+T PgFieldReader::DecodeFloat(const PgResultSet& result, int row, int column) {
+  auto value = Value(result, row, column);
+  if (!IsBinary(result, column)) {
+    return pqxx::from_string<T>(value);
+  }
+
+  return static_cast<T>(helper::ReadFloat(value, result.ColumnType(column)));
+}
+
+// static
+inline FieldStatus PgFieldReader::TryValue(const PgResultSet& result, int row,
+                                           int column,
+                                           std::string_view& value) {
+  if (column < 0 || column >= result.Columns()) {
+    return FieldStatus::UnknownColumn;
+  }
+
+  if (result.IsNull(row, column)) {
+    return FieldStatus::Null;
+  }
+
+  value = result.Value(row, column);
+  return FieldStatus::Ok;
+}
+
+// static
+template <typename T>
+FieldStatus PgFieldReader::TryDecodeInteger(const PgResultSet& result,
+                                            int row, int column, T& value) {
+  std::string_view raw;
+  auto status = TryValue(result, row, column, raw);
+  if (status != FieldStatus::Ok) {
+    return status;
+  }
+
+  if (!IsBinary(result, column)) {
+    T decoded;
+    auto end = raw.data() + raw.size();
+    auto [ptr, ec] = std::from_chars(raw.data(), end, decoded);
+    if (ec != std::errc() || ptr != end) {
+      return FieldStatus::Invalid;
+    }
+    value = decoded;
+    return FieldStatus::Ok;
+  }
+
+  int64_t decoded;
+  if (!helper::TryReadInteger(raw, result.ColumnType(column), decoded) ||
+      decoded < std::numeric_limits<T>::min() ||
+      decoded > std::numeric_limits<T>::max()) {
+    return FieldStatus::Invalid;
+  }
+  value = static_cast<T>(decoded);
+  return FieldStatus::Ok;
+}
+
+// static
+template <typename T>
+FieldStatus PgFieldReader::TryDecodeFloat(const PgResultSet& result, int row,
+                                          int column, T& value) {
+  std::string_view raw;
+  auto status = TryValue(result, row, column, raw);
+  if (status != FieldStatus::Ok) {
+    return status;
+  }
+
+  if (!IsBinary(result, column)) {
+    // Postgres prints NaN/Infinity, accepted by from_chars as well
+    T decoded;
+    auto end = raw.data() + raw.size();
+    auto [ptr, ec] = std::from_chars(raw.data(), end, decoded);
+    if (ec != std::errc() || ptr != end) {
+      return FieldStatus::Invalid;
+    }
+    value = decoded;
+    return FieldStatus::Ok;
+  }
+
+  double decoded;
+  if (!helper::TryReadFloat(raw, result.ColumnType(column), decoded)) {
+    return FieldStatus::Invalid;
+  }
+  value = static_cast<T>(decoded);
+  return FieldStatus::Ok;
+}
+
+NVSERV_END_NAMESPACE
@@ -21,38 +21,267 @@
 
 #include "nvserv/storages/postgres/pg_helper.h"
 
-#include <ctime>
-#include <iomanip>
-#include <sstream>
+#include <date/tz.h>
+
+#include <stdexcept>
+
+#include "nvserv/storages/postgres/pg_binary.h"
 
 NVSERV_BEGIN_NAMESPACE(storages::postgres::helper)
 
+namespace {
+
+constexpr int64_t MICROS_PER_SECOND = 1000000;
+constexpr int64_t SECONDS_PER_DAY = 86400;
+
+[[noreturn]] void ThrowMalformed(std::string_view timestamp) {
+  throw std::invalid_argument("Malformed timestamp [" +
+                              std::string(timestamp) + "]");
+}
+
+bool IsDigit(char c) {
+  return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// Fixed width digits at pos, advances pos
+int ReadDigits(std::string_view value, size_t& pos, size_t width) {
+  if (pos + width > value.size()) {
+    ThrowMalformed(value);
+  }
+
+  int result = 0;
+  for (size_t i = 0; i < width; i++) {
+    auto c = value[pos + i];
+    if (!IsDigit(c)) {
+      ThrowMalformed(value);
+    }
+    result = result * 10 + (c - '0');
+  }
+  pos += width;
+  return result;
+}
+
+void Expect(std::string_view value, size_t& pos, char expected) {
+  if (pos >= value.size() || value[pos] != expected) {
+    ThrowMalformed(value);
+  }
+  pos++;
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant)
+int64_t DaysFromCivil(int64_t year, int month, int day) {
+  year -= month <= 2;
+  const int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const int64_t yoe = year - era * 400;
+  const int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+// Proleptic Gregorian date of days since 1970-01-01, see DaysFromCivil
+void CivilFromDays(int64_t days, int64_t& year, int& month, int& day) {
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const int64_t doe = days - era * 146097;
+  const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const int64_t mp = (5 * doy + 2) / 153;
+  day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+  year = yoe + era * 400 + (month <= 2);
+}
+
+// Zero padded `width` digits at least, value is not negative
+void AppendDigits(std::string& out, int64_t value, size_t width) {
+  char digits[20];
+  size_t count = 0;
+  do {
+    digits[count++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+
+  for (; count < width; width--) {
+    out.push_back('0');
+  }
+  while (count > 0) {
+    out.push_back(digits[--count]);
+  }
+}
+
+}  // namespace
+
+int64_t ParseTimestampMicros(std::string_view timestamp) {
+  if (timestamp == "infinity") {
+    return TIMESTAMP_INFINITY;
+  }
+  if (timestamp == "-infinity") {
+    return TIMESTAMP_NEGATIVE_INFINITY;
+  }
+
+  size_t pos = 0;
+
+  // Postgres prints years above 9999 with more digits
+  size_t year_digits = 0;
+  while (year_digits < timestamp.size() && IsDigit(timestamp[year_digits])) {
+    year_digits++;
+  }
+  if (year_digits < 4) {
+    ThrowMalformed(timestamp);
+  }
+  int64_t year = ReadDigits(timestamp, pos, year_digits);
+  Expect(timestamp, pos, '-');
+  int month = ReadDigits(timestamp, pos, 2);
+  Expect(timestamp, pos, '-');
+  int day = ReadDigits(timestamp, pos, 2);
+
+  if (pos >= timestamp.size() ||
+      (timestamp[pos] != ' ' && timestamp[pos] != 'T')) {
+    ThrowMalformed(timestamp);
+  }
+  pos++;
+
+  int hour = ReadDigits(timestamp, pos, 2);
+  Expect(timestamp, pos, ':');
+  int minute = ReadDigits(timestamp, pos, 2);
+  Expect(timestamp, pos, ':');
+  int second = ReadDigits(timestamp, pos, 2);
+
+  if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 24 ||
+      minute > 59 || second > 60) {
+    ThrowMalformed(timestamp);
+  }
+
+  int64_t fraction = 0;
+  if (pos < timestamp.size() && timestamp[pos] == '.') {
+    pos++;
+    int64_t scale = 100000;
+    size_t digits = 0;
+    while (pos < timestamp.size() && IsDigit(timestamp[pos])) {
+      // Beyond microseconds is truncated
+      fraction += (timestamp[pos] - '0') * scale;
+      scale /= 10;
+      pos++;
+      digits++;
+    }
+    if (digits == 0) {
+      ThrowMalformed(timestamp);
+    }
+  }
+
+  int64_t offset_seconds = 0;
+  if (pos < timestamp.size()) {
+    auto sign = timestamp[pos];
+    if (sign == 'Z') {
+      pos++;
+    } else if (sign == '+' || sign == '-') {
+      pos++;
+      offset_seconds = ReadDigits(timestamp, pos, 2) * 3600;
+      if (pos < timestamp.size() && timestamp[pos] == ':') {
+        pos++;
+        offset_seconds += ReadDigits(timestamp, pos, 2) * 60;
+        if (pos < timestamp.size() && timestamp[pos] == ':') {
+          pos++;
+          offset_seconds += ReadDigits(timestamp, pos, 2);
+        }
+      } else if (pos < timestamp.size() && IsDigit(timestamp[pos])) {
+        // Basic ISO-8601 form +HHMM
+        offset_seconds += ReadDigits(timestamp, pos, 2) * 60;
+      }
+      if (sign == '-') {
+        offset_seconds = -offset_seconds;
+      }
+    }
+  }
+
+  // Era suffix, there is no year 0: 1 BC is year 0, 2 BC is year -1
+  if (timestamp.substr(pos) == " BC") {
+    if (year == 0) {
+      ThrowMalformed(timestamp);
+    }
+    year = 1 - year;
+    pos = timestamp.size();
+  }
+
+  if (pos != timestamp.size()) {
+    ThrowMalformed(timestamp);
+  }
+
+  auto seconds = DaysFromCivil(year, month, day) * SECONDS_PER_DAY +
+                 hour * 3600 + minute * 60 + second - offset_seconds;
+  return seconds * MICROS_PER_SECOND + fraction;
+}
+
 std::chrono::system_clock::time_point ParseTimestamp(
-    const std::string& timestamp) {
-  std::istringstream ss(timestamp);
-  std::tm tm = {};
-  ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
-  std::time_t time_c = std::mktime(&tm);
-  return std::chrono::system_clock::from_time_t(time_c);
+    std::string_view timestamp) {
+  return MicrosToTimePoint(ParseTimestampMicros(timestamp));
 }
 
 std::chrono::system_clock::time_point ParseTimestampz(
-    const std::string& timestamp) {
-  std::istringstream ss(timestamp);
-  std::tm tm = {};
-  ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    std::string_view timestamp) {
+  return ParseTimestamp(timestamp);
+}
+
+std::string FormatTimestamp(
+    const std::chrono::system_clock::time_point& time_point) {
+  if (time_point == std::chrono::system_clock::time_point::max()) {
+    return "infinity";
+  }
+  if (time_point == std::chrono::system_clock::time_point::min()) {
+    return "-infinity";
+  }
 
-  std::string tz_offset;
-  ss >> tz_offset;
-  if (!tz_offset.empty()) {
-    int hours = std::stoi(tz_offset.substr(0, 3));
-    int minutes = std::stoi(tz_offset.substr(4, 2));
-    tm.tm_hour -= hours;
-    tm.tm_min -= minutes;
+  auto micros = std::chrono::floor<std::chrono::microseconds>(
+                    time_point.time_since_epoch())
+                    .count();
+  auto seconds = micros / MICROS_PER_SECOND;
+  auto fraction = micros % MICROS_PER_SECOND;
+  if (fraction < 0) {
+    fraction += MICROS_PER_SECOND;
+    seconds--;
+  }
+  auto days = seconds / SECONDS_PER_DAY;
+  auto time = seconds % SECONDS_PER_DAY;
+  if (time < 0) {
+    time += SECONDS_PER_DAY;
+    days--;
   }
 
-  std::time_t time_c = std::mktime(&tm);
-  return std::chrono::system_clock::from_time_t(time_c);
+  int64_t year;
+  int month;
+  int day;
+  CivilFromDays(days, year, month, day);
+
+  std::string out;
+  out.reserve(32);
+  // There is no year 0: year 0 is 1 BC, year -1 is 2 BC
+  AppendDigits(out, year > 0 ? year : 1 - year, 4);
+  out.push_back('-');
+  AppendDigits(out, month, 2);
+  out.push_back('-');
+  AppendDigits(out, day, 2);
+  out.push_back(' ');
+  AppendDigits(out, time / 3600, 2);
+  out.push_back(':');
+  AppendDigits(out, time / 60 % 60, 2);
+  out.push_back(':');
+  AppendDigits(out, time % 60, 2);
+  if (fraction > 0) {
+    out.push_back('.');
+    AppendDigits(out, fraction, 6);
+  }
+  if (year <= 0) {
+    out.append(" BC");
+  }
+  return out;
+}
+
+nvm::dates::DateTime ToUtcDateTime(
+    const std::chrono::system_clock::time_point& time_point) {
+  // Looked up once, the tz database search is not repeated per value
+  static const date::time_zone* utc_zone = date::locate_zone("Etc/UTC");
+  return nvm::dates::DateTime(
+      date::zoned_time<std::chrono::system_clock::duration>(utc_zone,
+                                                            time_point));
 }
 
-NVSERV_END_NAMESPACE
\ No newline at end of file
+NVSERV_END_NAMESPACE
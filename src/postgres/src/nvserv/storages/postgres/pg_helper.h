@@ -22,17 +22,42 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
+#include "nvm/dates/datetime.h"
 #include "nvserv/global_macro.h"
 
 // cppcheck-suppress unknownMacro
 NVSERV_BEGIN_NAMESPACE(storages::postgres::helper)
 
+/// @brief Parse ISO-8601/Postgres text timestamp into unix microseconds UTC.
+/// Accepts "YYYY-MM-DD[ T]HH:MM:SS[.ffffff][Z|+HH[:MM[:SS]]][ BC]",
+/// fractions are truncated to microseconds, values without offset are UTC.
+/// "infinity"/"-infinity" return TIMESTAMP_INFINITY/
+/// TIMESTAMP_NEGATIVE_INFINITY, as the binary format does.
+/// No allocation & locale-independent, throws std::invalid_argument.
+int64_t ParseTimestampMicros(std::string_view timestamp);
+
+/// @brief Timestamp without time zone, the wall clock is taken as UTC.
+/// Infinity and the clock range are handled as MicrosToTimePoint() does.
 std::chrono::system_clock::time_point ParseTimestamp(
-    const std::string& timestamp);
+    std::string_view timestamp);
 
+/// @brief Timestamp with time zone, the offset is applied.
 std::chrono::system_clock::time_point ParseTimestampz(
-    const std::string& timestamp);
+    std::string_view timestamp);
+
+/// @brief Text timestamp "YYYY-MM-DD HH:MM:SS[.ffffff][ BC]" of the UTC
+/// wall clock, the inverse of ParseTimestamp(). time_point::max()/min()
+/// are formatted as "infinity"/"-infinity", as WriteTimestamp() does.
+std::string FormatTimestamp(
+    const std::chrono::system_clock::time_point& time_point);
+
+/// @brief DateTime in UTC, the zone is looked up once and shared by every
+/// decoded value.
+nvm::dates::DateTime ToUtcDateTime(
+    const std::chrono::system_clock::time_point& time_point);
 
-NVSERV_END_NAMESPACE
\ No newline at end of file
+NVSERV_END_NAMESPACE
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_multiplexer.h"
+
+#include "nvserv/storages/postgres/pg_transaction.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+/* PgMultiplexer */
+
+PgMultiplexer::PgMultiplexer(ConnectionPoolPtr pool, PgReactorPtr reactor,
+                             uint16_t connections)
+                : pool_(std::move(pool)),
+                  reactor_(std::move(reactor)),
+                  connections_count_(connections == 0 ? DEFAULT_CONNECTIONS
+                                                      : connections),
+                  connections_(),
+                  next_(0),
+                  binary_format_(false),
+                  is_run_(false) {}
+
+PgMultiplexer::~PgMultiplexer() {
+  Stop();
+}
+
+void PgMultiplexer::Start() {
+  absl::MutexLock lock(&mutex_);
+  if (is_run_) {
+    return;
+  }
+
+  if (!pool_ || !reactor_ || !reactor_->IsRun()) {
+    throw StorageException("PgMultiplexer requires running pool and reactor",
+                           StorageType::Postgres);
+  }
+
+  for (uint16_t i = 0; i < connections_count_; i++) {
+    auto conn = pool_->Acquire();
+    if (!conn) {
+      break;
+    }
+
+    auto shared = std::make_shared<SharedConnection>();
+    shared->conn = std::static_pointer_cast<PgConnection>(conn);
+    connections_.emplace_back(std::move(shared));
+  }
+
+  if (connections_.empty()) {
+    throw ConnectionException(
+        "PgMultiplexer can't acquired connection from pool",
+        StorageType::Postgres);
+  }
+
+  is_run_ = true;
+}
+
+void PgMultiplexer::Stop() {
+  absl::MutexLock lock(&mutex_);
+  if (!is_run_) {
+    return;
+  }
+
+  for (auto& shared : connections_) {
+    // Jobs still in the reactor hold the connection in pipeline mode
+    absl::MutexLock conn_lock(&shared->mutex);
+    WaitIdle(*shared);
+    pool_->Return(shared->conn);
+  }
+
+  connections_.clear();
+  is_run_ = false;
+}
+
+bool PgMultiplexer::IsRun() const {
+  absl::MutexLock lock(&mutex_);
+  return is_run_;
+}
+
+uint16_t PgMultiplexer::Connections() const {
+  return connections_count_;
+}
+
+void PgMultiplexer::SetBinaryFormat(bool enabled) {
+  binary_format_.store(enabled, std::memory_order_relaxed);
+}
+
+std::future<ExecutionResultPtr> PgMultiplexer::Submit(
+    std::string query, const parameters::ParamView& args, bool prepared) {
+  if (query.empty()) {
+    throw TransactionException("Exceptions on empty sql query on Execute",
+                               StorageType::Postgres);
+  }
+
+  PgAsyncStatement statement;
+  bool binary = binary_format_.load(std::memory_order_relaxed);
+  if (!prepared) {
+    Encode(statement, nullptr, args, binary);
+  }
+
+  absl::ReaderMutexLock lock(&mutex_);
+  if (!is_run_) {
+    throw TransactionException("PgMultiplexer is not running",
+                               StorageType::Postgres);
+  }
+
+  auto& shared = connections_[next_.fetch_add(1, std::memory_order_relaxed) %
+                              connections_.size()];
+
+  // Statement that prepares the name must enter the pipeline
+  // before any statement that uses it.
+  absl::MutexLock conn_lock(&shared->mutex);
+  auto raw = shared->conn->RawHandle();
+  if (shared->broken || !raw ||
+      (shared->inflight == 0 && PQstatus(raw) == CONNECTION_BAD)) {
+    Reopen(*shared);
+  }
+
+  std::optional<StatementId> id;
+  if (prepared) {
+    auto key = shared->conn->PrepareStatement(query);
+    if (!key.has_value()) {
+      throw TransactionException("Exceptions on empty sql query on Execute",
+                                 StorageType::Postgres);
+    }
+    id = key->Id();
+    const auto& catalog = shared->conn->PreparedStatement()->Catalog();
+    Encode(statement,
+           &impl::PreparedParamTypes(*catalog, key->Id(), {}, args, binary),
+           args, binary);
+    statement.name = key->Name();
+    statement.prepare = key->IsNew();
+
+    if (key->IsStale()) {
+      PgAsyncStatement deallocate;
+      deallocate.query = "DEALLOCATE " + key->Name();
+      deallocate.owner = TrackInflight(shared);
+      reactor_->Submit(shared->conn, std::move(deallocate), true);
+    }
+
+    if (key->HasEvicted()) {
+      PgAsyncStatement deallocate;
+      deallocate.query = "DEALLOCATE " + key->EvictedName();
+      deallocate.owner = TrackInflight(shared);
+      deallocate.on_error = OnDeallocateError(shared, key->EvictedId());
+      reactor_->Submit(shared->conn, std::move(deallocate), true);
+    }
+  }
+
+  statement.query = std::move(query);
+  statement.owner = TrackInflight(shared);
+  statement.on_error = OnError(shared, id);
+  return reactor_->Submit(shared->conn, std::move(statement), true);
+}
+
+// private:
+
+// static
+void PgMultiplexer::Encode(PgAsyncStatement& statement,
+                           const std::vector<uint32_t>* param_types,
+                           const parameters::ParamView& args, bool binary) {
+  if (binary) {
+    impl::TranslateBinaryParams(args, param_types, statement);
+    return;
+  }
+
+  if (param_types) {
+    statement.param_types = *param_types;
+  }
+  statement.values = impl::TranslateTextParams(args);
+}
+
+// static
+std::shared_ptr<void> PgMultiplexer::TrackInflight(
+    const SharedConnectionPtr& shared) {
+  shared->inflight++;
+  return std::shared_ptr<void>(nullptr, [shared](void*) {
+    absl::MutexLock lock(&shared->mutex);
+    shared->inflight--;
+  });
+}
+
+// static
+std::function<void(const std::string&, bool)> PgMultiplexer::OnError(
+    const SharedConnectionPtr& shared, std::optional<StatementId> id) {
+  return [shared, id](const std::string& sqlstate, bool prepare_failed) {
+    absl::MutexLock lock(&shared->mutex);
+    // SQLSTATE class 08, connection exception
+    if (sqlstate.compare(0, 2, "08") == 0) {
+      shared->broken = true;
+      return;
+    }
+
+    if (id.has_value()) {
+      shared->conn->PreparedStatementFailed(id.value(), sqlstate,
+                                            prepare_failed);
+    }
+  };
+}
+
+// static
+std::function<void(const std::string&, bool)>
+PgMultiplexer::OnDeallocateError(const SharedConnectionPtr& shared,
+                                 StatementId id) {
+  return [shared, id](const std::string& sqlstate, bool) {
+    absl::MutexLock lock(&shared->mutex);
+    if (sqlstate.compare(0, 2, "08") == 0) {
+      shared->broken = true;
+      return;
+    }
+
+    shared->conn->DeallocateFailed(id, sqlstate);
+  };
+}
+
+// static
+void PgMultiplexer::WaitIdle(SharedConnection& shared) {
+  shared.mutex.Await(absl::Condition(
+      +[](int* inflight) { return *inflight == 0; }, &shared.inflight));
+}
+
+// static
+void PgMultiplexer::Reopen(SharedConnection& shared) {
+  WaitIdle(shared);
+
+  // New session, prepared statements are registered again by Open
+  shared.conn->Release();
+  shared.conn->Open();
+  shared.broken = false;
+}
+
+/* PgMultiplexedTransaction */
+
+PgMultiplexedTransaction::PgMultiplexedTransaction(
+    PgMultiplexerPtr multiplexer, nvm::threads::TaskPoolPtr task_pool)
+                : Transaction(StorageType::Postgres,
+                              TransactionMode::NonTransaction,
+                              std::move(task_pool)),
+                  multiplexer_(std::move(multiplexer)) {}
+
+PgMultiplexedTransaction::~PgMultiplexedTransaction() {}
+
+// protected:
+
+void PgMultiplexedTransaction::CommitImpl() {
+  // No commit necessary for non-transaction
+}
+
+void PgMultiplexedTransaction::RollbackImpl() {
+  // No rollback necessary for non-transaction
+}
+
+ExecutionResultPtr PgMultiplexedTransaction::ExecuteImpl(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParamView& args) {
+  return multiplexer_
+      ->Submit(__NR_CALL_STRING_COMPAT_REF(query), args, true)
+      .get();
+}
+
+ExecutionResultPtr PgMultiplexedTransaction::ExecuteNonPreparedImpl(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParamView& args) {
+  return multiplexer_
+      ->Submit(__NR_CALL_STRING_COMPAT_REF(query), args, false)
+      .get();
+}
+
+std::future<ExecutionResultPtr> PgMultiplexedTransaction::ExecuteAsyncImpl(
+    std::string query, parameters::ParameterArgs args, bool prepared,
+    std::shared_ptr<void> /* owner */) {
+  // Parameters are encoded before returning, no need to keep them alive
+  return multiplexer_->Submit(std::move(query), args, prepared);
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "nvserv/global_macro.h"
+#include "nvserv/headers/absl_thread.h"
+#include "nvserv/storages/connection_pool.h"
+#include "nvserv/storages/postgres/declare.h"
+#include "nvserv/storages/postgres/pg_connection.h"
+#include "nvserv/storages/postgres/pg_reactor.h"
+#include "nvserv/storages/transaction.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+/// @brief Shares a few long-leased connections between many
+/// NonTransaction callers. Statements from any thread are pushed into the
+/// pipeline of one shared connection (round-robin) through PgReactor and
+/// their results are demultiplexed back to each caller in order.
+///
+/// Only safe for statements that do not depend on session state,
+/// every statement runs in its own implicit transaction.
+class PgMultiplexer {
+ public:
+  static constexpr uint16_t DEFAULT_CONNECTIONS = 1;
+
+  explicit PgMultiplexer(ConnectionPoolPtr pool, PgReactorPtr reactor,
+                         uint16_t connections = DEFAULT_CONNECTIONS);
+
+  ~PgMultiplexer();
+
+  /// @brief Lease the shared connections from the pool,
+  /// pool and reactor must be already running.
+  void Start();
+
+  /// @brief Return the shared connections to the pool.
+  void Stop();
+
+  bool IsRun() const;
+
+  uint16_t Connections() const;
+
+  /// @brief Binary parameters & results for statements submitted afterwards.
+  void SetBinaryFormat(bool enabled);
+
+  std::future<ExecutionResultPtr> Submit(std::string query,
+                                         const parameters::ParamView& args,
+                                         bool prepared);
+
+ private:
+  struct SharedConnection {
+    std::shared_ptr<PgConnection> conn;
+    // Keep prepared statement registration & submission in the same order
+    absl::Mutex mutex;
+    // Statements submitted and not yet completed by the reactor
+    int inflight = 0;
+    // Connection failure reported by the reactor, reopened on next submit
+    bool broken = false;
+  };
+  using SharedConnectionPtr = std::shared_ptr<SharedConnection>;
+
+  ConnectionPoolPtr pool_;
+  PgReactorPtr reactor_;
+  uint16_t connections_count_;
+  std::vector<SharedConnectionPtr> connections_;
+  std::atomic<size_t> next_;
+  std::atomic<bool> binary_format_;
+  bool is_run_;
+  mutable absl::Mutex mutex_;
+
+  // Text or binary parameters, `param_types` are the prepared ones,
+  // null declares them
+  static void Encode(PgAsyncStatement& statement,
+                     const std::vector<uint32_t>* param_types,
+                     const parameters::ParamView& args, bool binary);
+
+  // Statement owner counting it in-flight until the reactor released it,
+  // `shared.mutex` must be held
+  static std::shared_ptr<void> TrackInflight(const SharedConnectionPtr& shared);
+
+  // Failure handler of a statement: flags the connection broken on
+  // connection errors, otherwise keeps the prepared statement `id` in line
+  // (stale plan, rejected PREPARE)
+  static std::function<void(const std::string&, bool)> OnError(
+      const SharedConnectionPtr& shared, std::optional<StatementId> id);
+
+  // Failure handler of the DEALLOCATE of the evicted statement `id`
+  static std::function<void(const std::string&, bool)> OnDeallocateError(
+      const SharedConnectionPtr& shared, StatementId id);
+
+  // Block until the in-flight statements completed and the connection is
+  // back on blocking mode, `shared.mutex` must be held
+  static void WaitIdle(SharedConnection& shared);
+
+  // Replace the session of a broken connection, `shared.mutex` must be held
+  static void Reopen(SharedConnection& shared);
+};
+
+/// @brief NonTransaction that executes over PgMultiplexer shared
+/// connections instead of leasing its own connection from the pool.
+class PgMultiplexedTransaction final : public Transaction {
+ public:
+  explicit PgMultiplexedTransaction(PgMultiplexerPtr multiplexer,
+                                    nvm::threads::TaskPoolPtr task_pool);
+
+  ~PgMultiplexedTransaction();
+
+ protected:
+  // No operation, each statement is committed by the server
+  void CommitImpl() override;
+
+  // No operation, each statement is committed by the server
+  void RollbackImpl() override;
+
+  ExecutionResultPtr ExecuteImpl(
+      const __NR_STRING_COMPAT_REF query,
+      const parameters::ParamView& args) override;
+
+  ExecutionResultPtr ExecuteNonPreparedImpl(
+      const __NR_STRING_COMPAT_REF query,
+      const parameters::ParamView& args) override;
+
+  std::future<ExecutionResultPtr> ExecuteAsyncImpl(
+      std::string query, parameters::ParameterArgs args, bool prepared,
+      std::shared_ptr<void> owner) override;
+
+ private:
+  PgMultiplexerPtr multiplexer_;
+};
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_param_buffer.h"
+
+#include "nvserv/storages/postgres/pg_transaction.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+PgParamBuffer::PgParamBuffer() {}
+
+void PgParamBuffer::Encode(const parameters::ParamView& params,
+                           const std::vector<uint32_t>* declared_types,
+                           bool binary) {
+  data_.clear();
+  offsets_.clear();
+  values_.clear();
+  lengths_.clear();
+  formats_.clear();
+  types_.clear();
+
+  bool declare = declared_types == nullptr;
+  for (size_t i = 0; i < params.size(); i++) {
+    auto offset = data_.size();
+    uint32_t type = 0;
+    if (binary) {
+      type = impl::AppendBinaryParam(params[i], data_);
+      auto declared = declare ? type
+                      : i < declared_types->size() ? (*declared_types)[i]
+                                                   : 0;
+      if (type != 0 && type != declared) {
+        data_.resize(offset);
+        impl::AppendTextParam(params[i], data_);
+        type = 0;
+      }
+    } else {
+      impl::AppendTextParam(params[i], data_);
+    }
+
+    offsets_.push_back(offset);
+    lengths_.push_back(static_cast<int>(data_.size() - offset));
+    // libpq reads text values up to the terminator
+    data_.push_back('\0');
+    formats_.push_back(type != 0 ? 1 : 0);
+    if (declare) {
+      types_.push_back(binary ? type : 0);
+    } else {
+      types_.push_back(i < declared_types->size() ? (*declared_types)[i]
+                                                  : 0);
+    }
+  }
+
+  // Pointers only after the last append, the buffer might have grown
+  for (auto offset : offsets_) {
+    values_.push_back(data_.data() + offset);
+  }
+}
+
+int PgParamBuffer::Size() const {
+  return static_cast<int>(values_.size());
+}
+
+const char* const* PgParamBuffer::Values() const {
+  return values_.data();
+}
+
+const int* PgParamBuffer::Lengths() const {
+  return lengths_.data();
+}
+
+const int* PgParamBuffer::Formats() const {
+  return formats_.data();
+}
+
+const uint32_t* PgParamBuffer::Types() const {
+  return types_.data();
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/parameters/param_pack.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+/// @brief Reusable per-connection encoding buffer for libpq parameters.
+/// Every parameter is encoded once back-to-back (NUL terminated) into a
+/// single buffer, the pointer/length/format arrays are passed to libpq
+/// as they are.
+/// Capacity is kept between executions, so after warm-up encoding
+/// makes no heap allocation. Not thread-safe, owned by PgConnection.
+class PgParamBuffer {
+ public:
+  PgParamBuffer();
+
+  PgParamBuffer(const PgParamBuffer&) = delete;
+  PgParamBuffer& operator=(const PgParamBuffer&) = delete;
+
+  /// @brief Encode the parameters, previous content is discarded.
+  /// @param declared_types parameter types the statement was prepared with,
+  /// null to declare them from the parameters. A binary value is only sent
+  /// when its type matches the declared one (missing entries are inferred
+  /// by the server), otherwise as text.
+  /// @param binary binary format where possible, otherwise all text
+  void Encode(const parameters::ParamView& params,
+              const std::vector<uint32_t>* declared_types, bool binary);
+
+  int Size() const;
+
+  const char* const* Values() const;
+
+  const int* Lengths() const;
+
+  const int* Formats() const;
+
+  /// @brief Parameter type OIDs, 0 lets the server infer the type.
+  const uint32_t* Types() const;
+
+ private:
+  std::string data_;
+  std::vector<size_t> offsets_;
+  std::vector<const char*> values_;
+  std::vector<int> lengths_;
+  std::vector<int> formats_;
+  std::vector<uint32_t> types_;
+};
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_pipeline.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+namespace {
+
+// Leave pipeline mode on every exit of Run, otherwise the connection goes
+// back to the pool still in pipeline mode.
+class PipelineModeGuard {
+ public:
+  explicit PipelineModeGuard(PGconn* conn) : conn_(conn) {}
+
+  PipelineModeGuard(const PipelineModeGuard&) = delete;
+  PipelineModeGuard& operator=(const PipelineModeGuard&) = delete;
+
+  ~PipelineModeGuard() {
+    if (!conn_) {
+      return;
+    }
+
+    // Failed midway: close what was sent without a sync point,
+    // then drain the pending results until libpq lets us out.
+    PQpipelineSync(conn_);
+    while (PQexitPipelineMode(conn_) != 1 &&
+           PQstatus(conn_) == CONNECTION_OK) {
+      auto res = PQgetResult(conn_);
+      if (res) {
+        PQclear(res);
+      }
+    }
+  }
+
+  // Every result is read, report the failure to leave
+  void Exit() {
+    auto conn = conn_;
+    conn_ = nullptr;
+    if (PQexitPipelineMode(conn) != 1) {
+      throw ConnectionException(PQerrorMessage(conn), StorageType::Postgres);
+    }
+  }
+
+ private:
+  PGconn* conn_;
+};
+
+}  // namespace
+
+PgPipeline::PgPipeline(PGconn* conn)
+                : conn_(conn), statements_(), sync_after_() {}
+
+PgPipeline& PgPipeline::Add(PgAsyncStatement statement) {
+  statements_.emplace_back(std::move(statement));
+  sync_after_.push_back(false);
+  return *this;
+}
+
+PgPipeline& PgPipeline::Sync() {
+  if (!sync_after_.empty()) {
+    sync_after_.back() = true;
+  }
+  return *this;
+}
+
+size_t PgPipeline::Size() const {
+  return statements_.size();
+}
+
+std::vector<PgPipelineResult> PgPipeline::Run(bool sync_each) {
+  if (!conn_ || PQstatus(conn_) != CONNECTION_OK) {
+    throw ConnectionException("PgPipeline on broken connection",
+                              StorageType::Postgres);
+  }
+
+  std::vector<PgPipelineResult> results(statements_.size());
+  if (statements_.empty()) {
+    return results;
+  }
+
+  if (PQenterPipelineMode(conn_) != 1) {
+    throw ConnectionException(PQerrorMessage(conn_), StorageType::Postgres);
+  }
+  PipelineModeGuard guard(conn_);
+
+  for (size_t i = 0; i < statements_.size(); i++) {
+    Send(statements_[i]);
+    if (IsSyncPoint(i, sync_each) && !PQpipelineSync(conn_)) {
+      throw ConnectionException(PQerrorMessage(conn_), StorageType::Postgres);
+    }
+  }
+
+  // Every command yields its results terminated by NULL,
+  // followed by PGRES_PIPELINE_SYNC on each sync point.
+  for (size_t i = 0; i < statements_.size(); i++) {
+    if (statements_[i].prepare) {
+      ReadCommand(results[i], !statements_[i].execute);
+      results[i].prepare_failed = !results[i].Ok();
+    }
+    if (statements_[i].execute) {
+      ReadCommand(results[i], true);
+    }
+
+    if (IsSyncPoint(i, sync_each)) {
+      ReadSync();
+    }
+  }
+
+  guard.Exit();
+
+  statements_.clear();
+  sync_after_.clear();
+  return results;
+}
+
+// private:
+
+bool PgPipeline::IsSyncPoint(size_t index, bool sync_each) const {
+  return sync_each || sync_after_[index] || index + 1 == statements_.size();
+}
+
+void PgPipeline::Send(const PgAsyncStatement& statement) {
+  if (statement.prepare && !impl::SendPrepare(conn_, statement)) {
+    throw ConnectionException(PQerrorMessage(conn_), StorageType::Postgres);
+  }
+
+  if (statement.execute && !impl::SendExecute(conn_, statement)) {
+    throw ConnectionException(PQerrorMessage(conn_), StorageType::Postgres);
+  }
+}
+
+void PgPipeline::ReadCommand(PgPipelineResult& result, bool keep) {
+  PGresult* res = nullptr;
+  while ((res = PQgetResult(conn_)) != nullptr) {
+    auto status = PQresultStatus(res);
+    if (status == PGRES_PIPELINE_ABORTED) {
+      if (result.error.empty()) {
+        result.error = "Statement skipped, pipeline aborted";
+      }
+      PQclear(res);
+    } else if (status == PGRES_FATAL_ERROR || status == PGRES_BAD_RESPONSE ||
+               status == PGRES_NONFATAL_ERROR) {
+      if (result.error.empty()) {
+        result.error = PQresultErrorMessage(res);
+        auto sqlstate = PQresultErrorField(res, PG_DIAG_SQLSTATE);
+        result.sqlstate = sqlstate ? sqlstate : "";
+      }
+      PQclear(res);
+    } else if (keep && result.error.empty()) {
+      result.result = std::make_shared<const PgResultSet>(res);
+    } else {
+      PQclear(res);
+    }
+  }
+
+  if (PQstatus(conn_) != CONNECTION_OK) {
+    throw ConnectionException(PQerrorMessage(conn_), StorageType::Postgres);
+  }
+
+  if (!result.error.empty()) {
+    result.result = nullptr;
+  }
+}
+
+void PgPipeline::ReadSync() {
+  while (true) {
+    auto res = PQgetResult(conn_);
+    if (!res) {
+      if (PQstatus(conn_) != CONNECTION_OK) {
+        throw ConnectionException(PQerrorMessage(conn_),
+                                  StorageType::Postgres);
+      }
+      continue;
+    }
+
+    auto status = PQresultStatus(res);
+    PQclear(res);
+    if (status == PGRES_PIPELINE_SYNC) {
+      return;
+    }
+  }
+}
+
+NVSERV_END_NAMESPACE
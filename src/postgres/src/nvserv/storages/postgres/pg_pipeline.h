@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <libpq-fe.h>
+
+#include <string>
+#include <vector>
+
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/postgres/pg_reactor.h"
+#include "nvserv/storages/postgres/pg_result_set.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+struct PgPipelineResult {
+  // Null when the statement failed or skipped
+  PgResultSetPtr result;
+  std::string error;
+  std::string sqlstate;
+  // The PREPARE of the statement failed or was skipped
+  bool prepare_failed = false;
+
+  bool Ok() const {
+    return error.empty();
+  }
+};
+
+/// @brief Blocking batch of statements sent in one round trip
+/// with libpq pipeline mode.
+///
+/// Without `sync_each`, the whole batch shares one sync point:
+/// an error skips the remaining statements (e.g. BEGIN + statement).
+/// With `sync_each`, every statement is isolated from the others.
+/// `Sync` closes a segment in between, isolating the statements before it.
+/// The connection always leaves pipeline mode, even when Run throws.
+///
+/// Keep batches small, the connection is in blocking mode and
+/// results are only read after the whole batch is sent.
+class PgPipeline {
+ public:
+  explicit PgPipeline(PGconn* conn);
+
+  PgPipeline& Add(PgAsyncStatement statement);
+
+  /// @brief Sync point after the last added statement, its errors don't
+  /// skip the statements added afterwards.
+  PgPipeline& Sync();
+
+  size_t Size() const;
+
+  /// @brief Send the batch and collect the results in the same order.
+  /// Throws ConnectionException when the connection is broken.
+  std::vector<PgPipelineResult> Run(bool sync_each = false);
+
+ private:
+  PGconn* conn_;
+  std::vector<PgAsyncStatement> statements_;
+  std::vector<bool> sync_after_;
+
+  bool IsSyncPoint(size_t index, bool sync_each) const;
+
+  void Send(const PgAsyncStatement& statement);
+
+  void ReadCommand(PgPipelineResult& result, bool keep);
+
+  void ReadSync();
+};
+
+NVSERV_END_NAMESPACE
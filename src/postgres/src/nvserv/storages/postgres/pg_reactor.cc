@@ -0,0 +1,674 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_reactor.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <thread>
+
+#include "nvserv/storages/exceptions.h"
+#include "nvserv/storages/postgres/pg_execution_result.h"
+#include "nvserv/storages/postgres/pg_result_set.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+namespace impl {
+
+enum class PgReactorStage { Preparing, Executing };
+
+struct PgReactorJob {
+  std::shared_ptr<PgConnection> conn;
+  PgAsyncStatement statement;
+  bool pipelined = false;
+  std::promise<ExecutionResultPtr> promise;
+  PgReactorStage stage = PgReactorStage::Executing;
+  PGresult* result = nullptr;
+  std::string error;
+  std::string sqlstate;
+  // Error raised by the PREPARE of the statement
+  bool prepare_failed = false;
+
+  ~PgReactorJob() {
+    if (result) {
+      PQclear(result);
+    }
+    // Never reached the reactor, e.g. rejected by Submit
+    if (statement.on_finish) {
+      statement.on_finish();
+    }
+  }
+};
+
+using PgReactorJobPtr = std::unique_ptr<PgReactorJob>;
+
+int SendPrepare(PGconn* raw, const PgAsyncStatement& statement) {
+  return PQsendPrepare(raw, statement.name.c_str(), statement.query.c_str(),
+                       static_cast<int>(statement.param_types.size()),
+                       statement.param_types.empty()
+                           ? nullptr
+                           : statement.param_types.data());
+}
+
+int SendExecute(PGconn* raw, const PgAsyncStatement& statement) {
+  auto n_params = static_cast<int>(statement.values.size());
+  std::vector<const char*> values;
+  values.reserve(n_params);
+  for (const auto& value : statement.values) {
+    values.push_back(value.c_str());
+  }
+
+  // Binary values may contain NUL, lengths are required
+  std::vector<int> lengths;
+  if (!statement.formats.empty()) {
+    lengths.reserve(n_params);
+    for (const auto& value : statement.values) {
+      lengths.push_back(static_cast<int>(value.size()));
+    }
+  }
+  const int* formats =
+      statement.formats.empty() ? nullptr : statement.formats.data();
+  const int* length_ptr = lengths.empty() ? nullptr : lengths.data();
+  int result_format = statement.binary_result ? 1 : 0;
+
+  if (statement.name.empty()) {
+    return PQsendQueryParams(
+        raw, statement.query.c_str(), n_params,
+        statement.param_types.empty() ? nullptr : statement.param_types.data(),
+        values.data(), length_ptr, formats, result_format);
+  }
+
+  return PQsendQueryPrepared(raw, statement.name.c_str(), n_params,
+                             values.data(), length_ptr, formats,
+                             result_format);
+}
+
+}  // namespace impl
+
+/// Single reactor thread, owns an epoll instance and
+/// an eventfd to wake-up the thread when new jobs are posted.
+class PgReactor::EventLoop {
+ public:
+  EventLoop() : epoll_fd_(-1), wakeup_fd_(-1), is_run_(false) {}
+
+  ~EventLoop() {
+    Stop();
+  }
+
+  void Start() {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wakeup_fd_ < 0) {
+      CloseDescriptors();
+      throw InternalErrorException(
+          std::string("PgReactor failed to create epoll: ") +
+              std::strerror(errno),
+          StorageType::Postgres);
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = wakeup_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &ev);
+
+    is_run_ = true;
+    thread_ = std::thread([this]() { Run(); });
+  }
+
+  void Stop() {
+    if (!is_run_.exchange(false)) {
+      return;
+    }
+
+    Wakeup();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+
+    CloseDescriptors();
+  }
+
+  void Post(impl::PgReactorJobPtr job) {
+    {
+      absl::MutexLock lock(&inbox_mutex_);
+      inbox_.emplace_back(std::move(job));
+    }
+    Wakeup();
+  }
+
+ private:
+  struct ConnectionState {
+    std::shared_ptr<PgConnection> conn;
+    PGconn* raw = nullptr;
+    // Sequential: only the front job is sent.
+    // Pipeline: every job is sent, waiting for its results in order.
+    std::deque<impl::PgReactorJobPtr> jobs;
+    bool want_write = false;
+    bool pipeline = false;
+  };
+
+  int epoll_fd_;
+  int wakeup_fd_;
+  std::atomic<bool> is_run_;
+  std::thread thread_;
+
+  absl::Mutex inbox_mutex_;
+  std::vector<impl::PgReactorJobPtr> inbox_;
+
+  // Only touched by the reactor thread, keyed by socket
+  absl::flat_hash_map<int, ConnectionState> connections_;
+
+  void Wakeup() {
+    uint64_t one = 1;
+    if (wakeup_fd_ >= 0) {
+      [[maybe_unused]] auto n = write(wakeup_fd_, &one, sizeof(one));
+    }
+  }
+
+  void CloseDescriptors() {
+    if (epoll_fd_ >= 0) {
+      close(epoll_fd_);
+      epoll_fd_ = -1;
+    }
+    if (wakeup_fd_ >= 0) {
+      close(wakeup_fd_);
+      wakeup_fd_ = -1;
+    }
+  }
+
+  void Run() {
+    epoll_event events[PgReactor::MAX_EVENTS];
+
+    while (is_run_) {
+      auto count = epoll_wait(epoll_fd_, events, PgReactor::MAX_EVENTS, -1);
+      if (count < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+
+      for (int i = 0; i < count; i++) {
+        if (events[i].data.fd == wakeup_fd_) {
+          uint64_t value = 0;
+          [[maybe_unused]] auto n = read(wakeup_fd_, &value, sizeof(value));
+          DrainInbox();
+          continue;
+        }
+        HandleEvent(events[i].data.fd, events[i].events);
+      }
+    }
+
+    // Reactor stopped, nobody will complete the remaining jobs
+    DrainInbox();
+    std::vector<int> sockets;
+    for (auto& item : connections_) {
+      sockets.push_back(item.first);
+    }
+    for (auto fd : sockets) {
+      FailAll(fd, "PgReactor stopped before the statement completed");
+    }
+  }
+
+  void DrainInbox() {
+    std::vector<impl::PgReactorJobPtr> jobs;
+    {
+      absl::MutexLock lock(&inbox_mutex_);
+      jobs.swap(inbox_);
+    }
+
+    for (auto& job : jobs) {
+      auto raw = job->conn->RawHandle();
+      auto fd = raw ? PQsocket(raw) : -1;
+      if (fd < 0) {
+        Finish(*job);
+        if (job->statement.on_error) {
+          job->statement.on_error(impl::PG_CONNECTION_FAILURE,
+                                  job->statement.prepare);
+        }
+        job->promise.set_exception(std::make_exception_ptr(ConnectionException(
+            "PgReactor connection is not open", StorageType::Postgres)));
+        continue;
+      }
+
+      if (!is_run_) {
+        Finish(*job);
+        job->promise.set_exception(std::make_exception_ptr(ConnectionException(
+            "PgReactor is not running", StorageType::Postgres)));
+        continue;
+      }
+
+      auto it = connections_.find(fd);
+      if (it == connections_.end()) {
+        if (!Attach(fd, job->conn, raw, job->pipelined)) {
+          Finish(*job);
+          job->promise.set_exception(std::make_exception_ptr(
+              ConnectionException("PgReactor failed to register connection",
+                                  StorageType::Postgres)));
+          continue;
+        }
+        it = connections_.find(fd);
+      }
+
+      auto& state = it->second;
+      state.jobs.emplace_back(std::move(job));
+      if (state.pipeline) {
+        SendPipelined(fd);
+      } else if (state.jobs.size() == 1) {
+        StartJob(fd);
+      }
+    }
+  }
+
+  bool Attach(int fd, const std::shared_ptr<PgConnection>& conn, PGconn* raw,
+              bool pipeline) {
+    if (PQsetnonblocking(raw, 1) != 0) {
+      return false;
+    }
+
+    if (pipeline && PQenterPipelineMode(raw) != 1) {
+      PQsetnonblocking(raw, 0);
+      return false;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+      if (pipeline) {
+        PQexitPipelineMode(raw);
+      }
+      PQsetnonblocking(raw, 0);
+      return false;
+    }
+
+    ConnectionState state;
+    state.conn = conn;
+    state.raw = raw;
+    state.pipeline = pipeline;
+    connections_.emplace(fd, std::move(state));
+    return true;
+  }
+
+  void Detach(int fd) {
+    auto it = connections_.find(fd);
+    if (it == connections_.end()) {
+      return;
+    }
+
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    // Hand back the connection in blocking mode for pqxx
+    if (it->second.pipeline) {
+      PQexitPipelineMode(it->second.raw);
+    }
+    PQsetnonblocking(it->second.raw, 0);
+    connections_.erase(it);
+  }
+
+  void StartJob(int fd) {
+    auto& state = connections_.find(fd)->second;
+    auto& job = state.jobs.front();
+    job->stage = job->statement.prepare ? impl::PgReactorStage::Preparing
+                                        : impl::PgReactorStage::Executing;
+    SendStage(fd);
+  }
+
+  void SendStage(int fd) {
+    auto& state = connections_.find(fd)->second;
+    auto& job = state.jobs.front();
+
+    int sent = job->stage == impl::PgReactorStage::Preparing
+                   ? impl::SendPrepare(state.raw, job->statement)
+                   : impl::SendExecute(state.raw, job->statement);
+
+    if (!sent) {
+      job->error = PQerrorMessage(state.raw);
+      job->sqlstate = impl::PG_CONNECTION_FAILURE;
+      job->prepare_failed = job->stage == impl::PgReactorStage::Preparing;
+      CompleteJob(fd);
+      return;
+    }
+
+    Flush(fd);
+  }
+
+  // Queue the newest job into the pipeline, closed by its own sync point
+  // so an error only aborts that statement.
+  void SendPipelined(int fd) {
+    auto& state = connections_.find(fd)->second;
+    auto& job = state.jobs.back();
+    job->stage = job->statement.prepare ? impl::PgReactorStage::Preparing
+                                        : impl::PgReactorStage::Executing;
+
+    bool sent = (!job->statement.prepare ||
+                 impl::SendPrepare(state.raw, job->statement)) &&
+                impl::SendExecute(state.raw, job->statement) &&
+                PQpipelineSync(state.raw);
+
+    if (!sent) {
+      // Pipeline is in unknown state, fail everything on this connection
+      FailAll(fd, PQerrorMessage(state.raw));
+      return;
+    }
+
+    Flush(fd);
+  }
+
+  void Flush(int fd) {
+    auto& state = connections_.find(fd)->second;
+    auto flushed = PQflush(state.raw);
+    if (flushed < 0) {
+      FailAll(fd, PQerrorMessage(state.raw));
+      return;
+    }
+
+    bool want_write = flushed == 1;
+    if (want_write != state.want_write) {
+      state.want_write = want_write;
+      epoll_event ev{};
+      ev.events = EPOLLIN | (want_write ? EPOLLOUT : 0);
+      ev.data.fd = fd;
+      epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev);
+    }
+  }
+
+  void HandleEvent(int fd, uint32_t events) {
+    auto it = connections_.find(fd);
+    if (it == connections_.end()) {
+      return;
+    }
+
+    if ((events & EPOLLOUT) && it->second.want_write) {
+      Flush(fd);
+      if (connections_.find(fd) == connections_.end()) {
+        return;
+      }
+    }
+
+    if (events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+      auto& state = connections_.find(fd)->second;
+      if (!PQconsumeInput(state.raw)) {
+        FailAll(fd, PQerrorMessage(state.raw));
+        return;
+      }
+      if (connections_.find(fd)->second.pipeline) {
+        ReadPipelineResults(fd);
+      } else {
+        ReadResults(fd);
+      }
+    }
+  }
+
+  void ReadResults(int fd) {
+    while (true) {
+      auto it = connections_.find(fd);
+      if (it == connections_.end() || it->second.jobs.empty()) {
+        return;
+      }
+
+      auto& state = it->second;
+      if (PQisBusy(state.raw)) {
+        return;
+      }
+
+      auto result = PQgetResult(state.raw);
+      auto& job = state.jobs.front();
+
+      if (!result) {
+        // Current stage is finished
+        if (job->stage == impl::PgReactorStage::Preparing &&
+            job->error.empty()) {
+          job->stage = impl::PgReactorStage::Executing;
+          SendStage(fd);
+        } else {
+          CompleteJob(fd);
+        }
+        continue;
+      }
+
+      auto status = PQresultStatus(result);
+      if (status == PGRES_FATAL_ERROR || status == PGRES_BAD_RESPONSE ||
+          status == PGRES_NONFATAL_ERROR) {
+        if (job->error.empty()) {
+          job->error = PQresultErrorMessage(result);
+          auto sqlstate = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+          job->sqlstate = sqlstate ? sqlstate : "";
+          job->prepare_failed = job->stage == impl::PgReactorStage::Preparing;
+        }
+        PQclear(result);
+      } else if (job->stage == impl::PgReactorStage::Executing) {
+        if (job->result) {
+          PQclear(job->result);
+        }
+        job->result = result;
+      } else {
+        PQclear(result);
+      }
+    }
+  }
+
+  // Per job the pipeline yields: [prepare result, NULL], statement results,
+  // NULL, then PGRES_PIPELINE_SYNC which completes the job.
+  void ReadPipelineResults(int fd) {
+    while (true) {
+      auto it = connections_.find(fd);
+      if (it == connections_.end() || it->second.jobs.empty()) {
+        return;
+      }
+
+      auto& state = it->second;
+      if (PQisBusy(state.raw)) {
+        return;
+      }
+
+      auto result = PQgetResult(state.raw);
+      auto& job = state.jobs.front();
+
+      if (!result) {
+        if (job->stage == impl::PgReactorStage::Preparing) {
+          job->stage = impl::PgReactorStage::Executing;
+        }
+        continue;
+      }
+
+      auto status = PQresultStatus(result);
+      if (status == PGRES_PIPELINE_SYNC) {
+        PQclear(result);
+        CompleteJob(fd);
+        continue;
+      }
+
+      if (status == PGRES_PIPELINE_ABORTED) {
+        if (job->error.empty()) {
+          job->error = "Statement skipped, pipeline aborted";
+          job->prepare_failed = job->stage == impl::PgReactorStage::Preparing;
+        }
+        PQclear(result);
+      } else if (status == PGRES_FATAL_ERROR ||
+                 status == PGRES_BAD_RESPONSE ||
+                 status == PGRES_NONFATAL_ERROR) {
+        if (job->error.empty()) {
+          job->error = PQresultErrorMessage(result);
+          auto sqlstate = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+          job->sqlstate = sqlstate ? sqlstate : "";
+          job->prepare_failed = job->stage == impl::PgReactorStage::Preparing;
+        }
+        PQclear(result);
+      } else if (job->stage == impl::PgReactorStage::Executing) {
+        if (job->result) {
+          PQclear(job->result);
+        }
+        job->result = result;
+      } else {
+        PQclear(result);
+      }
+    }
+  }
+
+  void CompleteJob(int fd) {
+    auto& state = connections_.find(fd)->second;
+    auto job = std::move(state.jobs.front());
+    state.jobs.pop_front();
+
+    auto timed_out = Finish(*job);
+    if (!job->error.empty()) {
+      if (job->statement.on_error) {
+        job->statement.on_error(job->sqlstate, job->prepare_failed);
+      }
+      if (timed_out || job->sqlstate == impl::PG_QUERY_CANCELED) {
+        job->promise.set_exception(std::make_exception_ptr(
+            QueryTimeoutException(job->error, StorageType::Postgres)));
+      } else {
+        job->promise.set_exception(std::make_exception_ptr(
+            ExecutionException(job->error, StorageType::Postgres)));
+      }
+    } else {
+      auto result = std::make_shared<const PgResultSet>(job->result);
+      job->result = nullptr;
+      job->promise.set_value(std::make_shared<PgExecutionResult>(result));
+    }
+
+    if (state.jobs.empty()) {
+      Detach(fd);
+    } else if (!state.pipeline) {
+      StartJob(fd);
+    }
+
+    // Release the owner only after the connection is back on blocking mode,
+    // the owner might return the connection to the pool on destruction.
+    job.reset();
+  }
+
+  void FailAll(int fd, const std::string& error) {
+    auto it = connections_.find(fd);
+    if (it == connections_.end()) {
+      return;
+    }
+
+    auto jobs = std::move(it->second.jobs);
+    Detach(fd);
+
+    for (auto& job : jobs) {
+      Finish(*job);
+      if (job->statement.on_error) {
+        job->statement.on_error(impl::PG_CONNECTION_FAILURE,
+                                job->statement.prepare);
+      }
+      job->promise.set_exception(std::make_exception_ptr(
+          ConnectionException(error, StorageType::Postgres)));
+    }
+  }
+
+  // Runs the finish hook once, ahead of the result and of the next statement.
+  // Unlike the owner it must not outlive the statement, a deadline left
+  // armed would cancel whatever runs next on the connection.
+  static bool Finish(impl::PgReactorJob& job) {
+    if (!job.statement.on_finish) {
+      return false;
+    }
+
+    auto on_finish = std::move(job.statement.on_finish);
+    job.statement.on_finish = nullptr;
+    return on_finish();
+  }
+};
+
+PgReactor::PgReactor(uint16_t threads)
+                : loops_(),
+                  threads_(threads == 0 ? DEFAULT_THREADS : threads),
+                  is_run_(false) {}
+
+PgReactor::~PgReactor() {
+  Stop();
+}
+
+void PgReactor::Start() {
+  absl::MutexLock lock(&mutex_);
+  if (is_run_) {
+    return;
+  }
+
+  for (uint16_t i = 0; i < threads_; i++) {
+    auto loop = std::make_unique<EventLoop>();
+    loop->Start();
+    loops_.emplace_back(std::move(loop));
+  }
+
+  is_run_ = true;
+}
+
+void PgReactor::Stop() {
+  absl::MutexLock lock(&mutex_);
+  if (!is_run_) {
+    return;
+  }
+
+  is_run_ = false;
+  for (auto& loop : loops_) {
+    loop->Stop();
+  }
+  loops_.clear();
+}
+
+bool PgReactor::IsRun() const {
+  absl::MutexLock lock(&mutex_);
+  return is_run_;
+}
+
+uint16_t PgReactor::Threads() const {
+  return threads_;
+}
+
+std::future<ExecutionResultPtr> PgReactor::Submit(
+    std::shared_ptr<PgConnection> conn, PgAsyncStatement&& statement,
+    bool pipelined) {
+  if (!conn) {
+    throw ConnectionException("PgReactor submit with null connection",
+                              StorageType::Postgres);
+  }
+
+  auto job = std::make_unique<impl::PgReactorJob>();
+  job->conn = std::move(conn);
+  job->statement = std::move(statement);
+  job->pipelined = pipelined;
+  auto future = job->promise.get_future();
+
+  absl::MutexLock lock(&mutex_);
+  if (!is_run_) {
+    throw ConnectionException("PgReactor is not running",
+                              StorageType::Postgres);
+  }
+
+  // Same connection always lands on the same loop to keep statement order
+  auto index = job->conn->GetHash() % loops_.size();
+  loops_[index]->Post(std::move(job));
+
+  return future;
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <libpq-fe.h>
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nvserv/global_macro.h"
+#include "nvserv/headers/absl_thread.h"
+#include "nvserv/storages/declare.h"
+#include "nvserv/storages/postgres/declare.h"
+#include "nvserv/storages/postgres/pg_connection.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+/// @brief Statement submitted to PgReactor.
+/// Parameter values are already encoded as postgres text representation.
+struct PgAsyncStatement {
+  // Prepared statement name, empty to execute `query` unprepared.
+  std::string name;
+  std::string query;
+  // Send PREPARE `name` AS `query` before the execution.
+  bool prepare = false;
+  // Parameter type OIDs used on PREPARE, empty lets the server infer them
+  std::vector<uint32_t> param_types;
+  // False only prepares the statement (PgPipeline only, e.g. warm-up)
+  bool execute = true;
+  std::vector<std::string> values;
+  // Format of each value (0 text, 1 binary), empty sends all as text
+  std::vector<int> formats;
+  // Request the results in binary format
+  bool binary_result = false;
+  // Kept alive until the statement completed,
+  // usually the transaction that leased the connection.
+  std::shared_ptr<void> owner;
+  // Called on the reactor thread when the statement failed, with the
+  // SQLSTATE reported by the server (PG_CONNECTION_FAILURE when the
+  // connection failed, empty when unknown). `prepare_failed` when the
+  // error came from the PREPARE of `name`.
+  std::function<void(const std::string& sqlstate, bool prepare_failed)>
+      on_error;
+  // Called on the reactor thread as soon as the statement finished, before
+  // the result is delivered and the next statement of the connection is
+  // sent, e.g. to drop the statement deadline. Returns true when the
+  // statement ran past its deadline, a failure is then a QueryTimeout.
+  std::function<bool()> on_finish;
+};
+
+namespace impl {
+
+// SQLSTATE connection_failure, reported when the connection itself failed
+constexpr const char* PG_CONNECTION_FAILURE = "08006";
+
+/// @brief PQsendPrepare of the statement `name`.
+int SendPrepare(PGconn* raw, const PgAsyncStatement& statement);
+
+/// @brief PQsendQueryPrepared, or PQsendQueryParams when unnamed.
+int SendExecute(PGconn* raw, const PgAsyncStatement& statement);
+
+}  // namespace impl
+
+/// @brief Non-blocking libpq execution engine.
+/// Each reactor thread multiplexes the sockets of many PgConnection with
+/// epoll, statements are sent with PQsendQueryPrepared/PQsendQueryParams and
+/// results are collected with PQconsumeInput/PQgetResult as they arrive.
+/// One thread drives as many concurrent statements as there are connections.
+///
+/// The connection is switched to non-blocking mode while it has statements
+/// in-flight and switched back when its queue is drained, the caller must
+/// not use the connection synchronously until the future is resolved.
+/// Statements of the same connection are executed in submission order.
+///
+/// When submitted `pipelined`, the connection is put in libpq pipeline mode
+/// and statements are sent as soon as they arrive, each one closed with its
+/// own sync point, results are demultiplexed back in submission order.
+class PgReactor {
+ public:
+  static constexpr uint16_t DEFAULT_THREADS = 1;
+  static constexpr int MAX_EVENTS = 128;
+
+  explicit PgReactor(uint16_t threads = DEFAULT_THREADS);
+
+  ~PgReactor();
+
+  void Start();
+
+  void Stop();
+
+  bool IsRun() const;
+
+  uint16_t Threads() const;
+
+  std::future<ExecutionResultPtr> Submit(std::shared_ptr<PgConnection> conn,
+                                         PgAsyncStatement&& statement,
+                                         bool pipelined = false);
+
+ private:
+  class EventLoop;
+
+  std::vector<std::unique_ptr<EventLoop>> loops_;
+  uint16_t threads_;
+  bool is_run_;
+  mutable absl::Mutex mutex_;
+};
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_result_set.h"
+
+#include <cstdlib>
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+PgResultSet::PgResultSet(pqxx::result&& result)
+                : result_(std::forward<pqxx::result>(result)), raw_(nullptr) {}
+
+PgResultSet::PgResultSet(PGresult* result) : result_(), raw_(result) {}
+
+PgResultSet::~PgResultSet() {
+  if (raw_) {
+    PQclear(raw_);
+    raw_ = nullptr;
+  }
+}
+
+size_t PgResultSet::AffectedRows() const {
+  if (raw_) {
+    const char* tuples = PQcmdTuples(raw_);
+    return tuples && *tuples ? std::strtoull(tuples, nullptr, 10) : 0;
+  }
+  return result_.affected_rows();
+}
+
+std::string PgResultSet::ColumnName(int column) const {
+  if (raw_) {
+    const char* name = PQfname(raw_, column);
+    return name ? std::string(name) : std::string();
+  }
+  return std::string(result_.column_name(column));
+}
+
+int PgResultSet::ColumnNumber(const std::string& column_name) const {
+  if (raw_) {
+    return PQfnumber(raw_, column_name.c_str());
+  }
+
+  try {
+    return static_cast<int>(result_.column_number(column_name));
+  } catch (const std::exception& e) {
+    return -1;
+  }
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <libpq-fe.h>
+
+#include <cstdint>
+#include <memory>
+#include <pqxx/pqxx>
+#include <string>
+#include <string_view>
+
+#include "nvserv/global_macro.h"
+
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+class PgResultSet;
+using PgResultSetPtr = std::shared_ptr<const PgResultSet>;
+
+/// @brief Immutable result set shared by PgExecutionResult and the rows
+/// created from it. Backed either by pqxx::result (pqxx execution path)
+/// or by raw libpq PGresult (reactor & raw execution path),
+/// rows & columns access is the same for both.
+/// Field accessors are defined inline below, they sit in the row loops.
+class PgResultSet {
+ public:
+  explicit PgResultSet(pqxx::result&& result);
+
+  /// @brief Take ownership of libpq result, PQclear on destruction.
+  explicit PgResultSet(PGresult* result);
+
+  PgResultSet(const PgResultSet&) = delete;
+  PgResultSet& operator=(const PgResultSet&) = delete;
+
+  ~PgResultSet();
+
+  bool Empty() const;
+
+  int Rows() const;
+
+  int Columns() const;
+
+  size_t AffectedRows() const;
+
+  bool IsNull(int row, int column) const;
+
+  /// @brief Raw field bytes, view is valid as long as the result set alive.
+  std::string_view Value(int row, int column) const;
+
+  std::string ColumnName(int column) const;
+
+  /// @brief Column index by name, -1 when the column is not exist.
+  int ColumnNumber(const std::string& column_name) const;
+
+  uint32_t ColumnType(int column) const;
+
+  /// @brief 0 for text, 1 for binary.
+  int ColumnFormat(int column) const;
+
+  bool IsRaw() const;
+
+ private:
+  pqxx::result result_;
+  PGresult* raw_;
+};
+
+inline bool PgResultSet::Empty() const {
+  return Rows() == 0;
+}
+
+inline int PgResultSet::Rows() const {
+  if (raw_) {
+    return PQntuples(raw_);
+  }
+  return static_cast<int>(result_.size());
+}
+
+inline int PgResultSet::Columns() const {
+  if (raw_) {
+    return PQnfields(raw_);
+  }
+  return static_cast<int>(result_.columns());
+}
+
+inline bool PgResultSet::IsNull(int row, int column) const {
+  if (raw_) {
+    return PQgetisnull(raw_, row, column) == 1;
+  }
+  return result_[row][column].is_null();
+}
+
+inline std::string_view PgResultSet::Value(int row, int column) const {
+  if (raw_) {
+    return std::string_view(PQgetvalue(raw_, row, column),
+                            PQgetlength(raw_, row, column));
+  }
+  auto field = result_[row][column];
+  return std::string_view(field.c_str(), field.size());
+}
+
+inline uint32_t PgResultSet::ColumnType(int column) const {
+  if (raw_) {
+    return PQftype(raw_, column);
+  }
+  return result_.column_type(column);
+}
+
+inline int PgResultSet::ColumnFormat(int column) const {
+  if (raw_) {
+    return PQfformat(raw_, column);
+  }
+  // pqxx always request text format
+  return 0;
+}
+
+inline bool PgResultSet::IsRaw() const {
+  return raw_ != nullptr;
+}
+
+NVSERV_END_NAMESPACE
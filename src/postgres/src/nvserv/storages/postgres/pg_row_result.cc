@@ -20,36 +20,47 @@
  */
 
 #include "nvserv/storages/postgres/pg_row_result.h"
+
 #include "nvserv/exceptions.h"
+#include "nvserv/storages/postgres/pg_field_reader.h"
 
 NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
-PgRowResult::PgRowResult(std::shared_ptr<pqxx::row> row)
-                : RowResult(), row_(row) {}
+PgRowResult::PgRowResult(PgResultSetPtr result, int row)
+                : RowResult(), result_(std::move(result)), row_(row) {}
 PgRowResult::~PgRowResult() = default;
 
 std::optional<Column> PgRowResult::GetColumn(
     const std::string& columnName) const  {
-  try {
-    return PgColumn((*row_)[columnName]);
-  } catch (const std::exception& e) {
+  auto index = result_->ColumnNumber(columnName);
+  if (index < 0) {
     return std::nullopt;
   }
+
+  return PgColumn(result_->ColumnName(index));
 }
 
 std::optional<Column> PgRowResult::GetColumn(const int& index) const  {
   
-  if (index<0 || index >= row_->size()) {
+  if (index<0 || index >= result_->Columns()) {
     // to avoid UB
     // we have to throws
     throw nvserv::OutOfBoundException("`GetColumn` index is out-of-bounds [" + std::to_string(index) + "]");
   }
 
-  return PgColumn(row_->at(index));
+  return PgColumn(result_->ColumnName(index));
 }
 
 size_t PgRowResult::Size() const  {
-  return row_->size();
+  return result_->Columns();
+}
+
+bool PgRowResult::IsNull(const int& index) const {
+  return PgFieldReader::IsNull(*result_, row_, index);
+}
+
+bool PgRowResult::IsNull(const std::string& column_name) const {
+  return PgFieldReader::IsNull(*result_, row_, ColumnIndex(column_name));
 }
 
 // ColumnIterator begin() const {
@@ -61,158 +72,147 @@ size_t PgRowResult::Size() const  {
 // }
 
 int16_t PgRowResult::AsImpl_int16_t(const int& index) const  {
-  try {
-    return row_->at(index).as<int16_t>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Int16(*result_, row_, index);
 };
 
 int32_t PgRowResult::AsImpl_int32_t(const int& index) const  {
-  try {
-    return row_->at(index).as<int32_t>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Int32(*result_, row_, index);
 };
 
 int64_t PgRowResult::AsImpl_int64_t(const int& index) const  {
-  try {
-    return row_->at(index).as<int64_t>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Int64(*result_, row_, index);
 };
 
 std::string PgRowResult::AsImpl_string(const int& index) const  {
-  try {
-    return row_->at(index).as<std::string>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::String(*result_, row_, index);
 };
 
 float PgRowResult::AsImpl_float(const int& index) const  {
-  try {
-    return row_->at(index).as<float>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Float(*result_, row_, index);
 };
 
 double PgRowResult::AsImpl_double(const int& index) const  {
-  try {
-    return row_->at(index).as<double>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Double(*result_, row_, index);
 };
 
 nvm::dates::DateTime PgRowResult::AsImpl_DateTime_Timestampz(
     const int& index) const  {
-  try {
-    auto time_point =
-        helper::ParseTimestampz(row_->at(index).as<std::string>());
-    return __NR_RETURN_MOVE(nvm::dates::DateTime(time_point, "Etc/Utc"));
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Timestampz(*result_, row_, index);
 };
 
 nvm::dates::DateTime PgRowResult::AsImpl_DateTime_Timestamp(
     const int& index) const  {
-  try {
-    auto time_point = helper::ParseTimestamp(row_->at(index).as<std::string>());
-    return __NR_RETURN_MOVE(nvm::dates::DateTime(time_point, "Etc/Utc"));
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Timestamp(*result_, row_, index);
 };
 
 int16_t PgRowResult::AsImpl_int16_t(const std::string& column_name) const  {
-  try {
-    return row_->at(column_name).as<int16_t>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Int16(*result_, row_, ColumnIndex(column_name));
 };
 
 int32_t PgRowResult::AsImpl_int32_t(const std::string& column_name) const  {
-  try {
-    return row_->at(column_name).as<int32_t>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Int32(*result_, row_, ColumnIndex(column_name));
 };
 
 int64_t PgRowResult::AsImpl_int64_t(const std::string& column_name) const  {
-  try {
-    return row_->at(column_name).as<int64_t>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Int64(*result_, row_, ColumnIndex(column_name));
 };
 
 std::string PgRowResult::AsImpl_string(const std::string& column_name) const  {
-  try {
-    return __NR_RETURN_MOVE(row_->at(column_name).as<std::string>());
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::String(*result_, row_, ColumnIndex(column_name));
 };
 
 float PgRowResult::AsImpl_float(const std::string& column_name) const  {
-  try {
-    return row_->at(column_name).as<float>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Float(*result_, row_, ColumnIndex(column_name));
 };
 
 double PgRowResult::AsImpl_double(const std::string& column_name) const  {
-  try {
-    return row_->at(column_name).as<double>();
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Double(*result_, row_, ColumnIndex(column_name));
 };
 
 nvm::dates::DateTime PgRowResult::AsImpl_DateTime_Timestampz(
     const std::string& column_name) const  {
-  try {
-    auto time_point =
-        helper::ParseTimestampz(row_->at(column_name).as<std::string>());
-    return __NR_RETURN_MOVE(nvm::dates::DateTime(time_point, "Etc/Utc"));
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Timestampz(*result_, row_, ColumnIndex(column_name));
 };
 
 nvm::dates::DateTime PgRowResult::AsImpl_DateTime_Timestamp(
     const std::string& column_name) const  {
-  try {
-    auto time_point =
-        helper::ParseTimestamp(row_->at(column_name).as<std::string>());
-    return __NR_RETURN_MOVE(nvm::dates::DateTime(time_point, "Etc/Utc"));
-  } catch (const std::exception& e) {
-    // std::cerr << e.what() << '\n';
-    throw std::invalid_argument(e.what());
-  }
+  return PgFieldReader::Timestamp(*result_, row_, ColumnIndex(column_name));
 };
 
-NVSERV_END_NAMESPACE
\ No newline at end of file
+std::string_view PgRowResult::AsImpl_string_view(const int& index) const {
+  return PgFieldReader::StringView(*result_, row_, index);
+}
+
+BytesView PgRowResult::AsImpl_bytes(const int& index) const {
+  return PgFieldReader::Bytes(*result_, row_, index);
+}
+
+std::vector<int16_t> PgRowResult::AsImpl_vector_int16_t(
+    const int& index) const {
+  return PgFieldReader::Array<int16_t>(*result_, row_, index);
+}
+
+std::vector<int32_t> PgRowResult::AsImpl_vector_int32_t(
+    const int& index) const {
+  return PgFieldReader::Array<int32_t>(*result_, row_, index);
+}
+
+std::vector<int64_t> PgRowResult::AsImpl_vector_int64_t(
+    const int& index) const {
+  return PgFieldReader::Array<int64_t>(*result_, row_, index);
+}
+
+std::vector<float> PgRowResult::AsImpl_vector_float(const int& index) const {
+  return PgFieldReader::Array<float>(*result_, row_, index);
+}
+
+std::vector<double> PgRowResult::AsImpl_vector_double(const int& index) const {
+  return PgFieldReader::Array<double>(*result_, row_, index);
+}
+
+std::vector<std::string> PgRowResult::AsImpl_vector_string(
+    const int& index) const {
+  return PgFieldReader::Array<std::string>(*result_, row_, index);
+}
+
+int PgRowResult::FindColumnIndex(const std::string& column_name) const {
+  return result_->ColumnNumber(column_name);
+}
+
+FieldStatus PgRowResult::TryAsImpl_int16_t(const int& index,
+                                           int16_t& value) const {
+  return PgFieldReader::TryInt16(*result_, row_, index, value);
+}
+
+FieldStatus PgRowResult::TryAsImpl_int32_t(const int& index,
+                                           int32_t& value) const {
+  return PgFieldReader::TryInt32(*result_, row_, index, value);
+}
+
+FieldStatus PgRowResult::TryAsImpl_int64_t(const int& index,
+                                           int64_t& value) const {
+  return PgFieldReader::TryInt64(*result_, row_, index, value);
+}
+
+FieldStatus PgRowResult::TryAsImpl_string(const int& index,
+                                          std::string& value) const {
+  return PgFieldReader::TryString(*result_, row_, index, value);
+}
+
+FieldStatus PgRowResult::TryAsImpl_float(const int& index,
+                                         float& value) const {
+  return PgFieldReader::TryFloat(*result_, row_, index, value);
+}
+
+FieldStatus PgRowResult::TryAsImpl_double(const int& index,
+                                          double& value) const {
+  return PgFieldReader::TryDouble(*result_, row_, index, value);
+}
+
+// private
+
+int PgRowResult::ColumnIndex(const std::string& column_name) const {
+  return PgFieldReader::ColumnIndex(*result_, column_name);
+}
+
+NVSERV_END_NAMESPACE
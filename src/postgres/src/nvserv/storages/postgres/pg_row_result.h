@@ -32,13 +32,14 @@
 #include "nvserv/storages/declare.h"
 #include "nvserv/storages/postgres/pg_column.h"
 #include "nvserv/storages/postgres/pg_helper.h"
+#include "nvserv/storages/postgres/pg_result_set.h"
 #include "nvserv/storages/row_result.h"
 
 NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
-class PgRowResult : public RowResult {
+class PgRowResult final : public RowResult {
  public:
-  explicit PgRowResult(std::shared_ptr<pqxx::row> row);
+  explicit PgRowResult(PgResultSetPtr result, int row);
   virtual ~PgRowResult();
   std::optional<Column> GetColumn(const std::string& columnName) const override;
 
@@ -46,6 +47,10 @@ class PgRowResult : public RowResult {
 
   size_t Size() const override;
 
+  bool IsNull(const int& index) const override;
+
+  bool IsNull(const std::string& column_name) const override;
+
   // ColumnIterator begin() const {
   //     return ColumnIterator(row_, 0);
   // }
@@ -90,8 +95,47 @@ class PgRowResult : public RowResult {
   nvm::dates::DateTime AsImpl_DateTime_Timestamp(
       const std::string& column_name) const override;
 
+  std::string_view AsImpl_string_view(const int& index) const override;
+
+  BytesView AsImpl_bytes(const int& index) const override;
+
+  std::vector<int16_t> AsImpl_vector_int16_t(const int& index) const override;
+
+  std::vector<int32_t> AsImpl_vector_int32_t(const int& index) const override;
+
+  std::vector<int64_t> AsImpl_vector_int64_t(const int& index) const override;
+
+  std::vector<float> AsImpl_vector_float(const int& index) const override;
+
+  std::vector<double> AsImpl_vector_double(const int& index) const override;
+
+  std::vector<std::string> AsImpl_vector_string(
+      const int& index) const override;
+
+  int FindColumnIndex(const std::string& column_name) const override;
+
+  FieldStatus TryAsImpl_int16_t(const int& index,
+                                int16_t& value) const override;
+
+  FieldStatus TryAsImpl_int32_t(const int& index,
+                                int32_t& value) const override;
+
+  FieldStatus TryAsImpl_int64_t(const int& index,
+                                int64_t& value) const override;
+
+  FieldStatus TryAsImpl_string(const int& index,
+                               std::string& value) const override;
+
+  FieldStatus TryAsImpl_float(const int& index, float& value) const override;
+
+  FieldStatus TryAsImpl_double(const int& index,
+                               double& value) const override;
+
  private:
-  std::shared_ptr<pqxx::row> row_;
+  PgResultSetPtr result_;
+  int row_;
+
+  int ColumnIndex(const std::string& column_name) const;
 };
 
 NVSERV_END_NAMESPACE
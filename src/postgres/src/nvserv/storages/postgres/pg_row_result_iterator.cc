@@ -23,8 +23,8 @@
 
 NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
-PgRowResultIterator::PgRowResultIterator(const pqxx::result& result, int index)
-                : result_(result), index_(index) {}
+PgRowResultIterator::PgRowResultIterator(PgResultSetPtr result, int index)
+                : result_(std::move(result)), index_(index) {}
 
 PgRowResultIterator& PgRowResultIterator::operator++() {
   ++index_;
@@ -33,7 +33,7 @@ PgRowResultIterator& PgRowResultIterator::operator++() {
 
 bool PgRowResultIterator::operator==(const RowResultIterator& other) const {
   auto other_pg = dynamic_cast<const PgRowResultIterator*>(&other);
-  return other_pg && &result_ == &(other_pg->result_) &&
+  return other_pg && result_ == other_pg->result_ &&
          index_ == other_pg->index_;
 }
 
@@ -42,8 +42,7 @@ bool PgRowResultIterator::operator!=(const RowResultIterator& other) const {
 }
 
 RowResultPtr PgRowResultIterator::operator*() const {
-  return std::move(std::make_shared<PgRowResult>(
-      std::make_shared<pqxx::row>(result_.at(index_))));
+  return std::move(std::make_shared<PgRowResult>(result_, index_));
 }
 
 std::unique_ptr<RowResultIterator> PgRowResultIterator::clone() const {
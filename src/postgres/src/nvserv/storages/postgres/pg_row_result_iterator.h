@@ -27,13 +27,14 @@
 
 #include "nvserv/global_macro.h"
 #include "nvserv/storages/declare.h"
+#include "nvserv/storages/postgres/pg_result_set.h"
 #include "nvserv/storages/postgres/pg_row_result.h"
 #include "nvserv/storages/row_result.h"
 #include "nvserv/storages/row_result_iterator.h"
 
 NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
-class PgRowResultIterator : public RowResultIterator {
+class PgRowResultIterator final : public RowResultIterator {
  public:
   using iterator_category = std::forward_iterator_tag;
   using value_type = RowResultPtr;
@@ -41,7 +42,7 @@ class PgRowResultIterator : public RowResultIterator {
   using pointer = const RowResultPtr*;
   using reference = const RowResultPtr&;
 
-  explicit PgRowResultIterator(const pqxx::result& result, int index);
+  explicit PgRowResultIterator(PgResultSetPtr result, int index);
                 
   PgRowResultIterator& operator++() override;
 
@@ -54,7 +55,7 @@ class PgRowResultIterator : public RowResultIterator {
   std::unique_ptr<RowResultIterator> clone() const override;
 
  private:
-  const pqxx::result& result_;
+  PgResultSetPtr result_;
   int index_;
 };
 
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_row_view.h"
+
+#include <stdexcept>
+
+#include "nvserv/storages/postgres/pg_execution_result.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+PgRowViewRange::PgRowViewRange(const PgResultSet& result)
+                : result_(&result) {}
+
+PgRowViewRange::PgRowViewRange(const ExecutionResult& result)
+                : result_(nullptr) {
+#if !NVQL_SINGLE_DRIVER
+  if (result.Type() != StorageType::Postgres) {
+    throw std::invalid_argument(
+        "PgRowViewRange only supports postgres result");
+  }
+#endif
+  result_ = static_cast<const PgExecutionResult&>(result).ResultSet().get();
+}
+
+NVSERV_END_NAMESPACE
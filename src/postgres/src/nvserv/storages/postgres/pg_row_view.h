@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nvm/dates/datetime.h"
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/bytes_view.h"
+#include "nvserv/storages/declare.h"
+#include "nvserv/storages/postgres/pg_field_reader.h"
+#include "nvserv/storages/postgres/pg_result_set.h"
+#include "nvserv/storages/row_result.h"
+#include "nvserv/storages/row_view.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages::postgres)
+
+/// @brief Postgres specialization of RowView, calls PgFieldReader directly
+/// instead of going through ExecutionResult virtual accessors,
+/// so column access inlines into tight loops.
+/// Valid as long as the PgResultSet is alive.
+class PgRowView {
+ public:
+  PgRowView() : result_(nullptr), row_(0) {}
+
+  explicit PgRowView(const PgResultSet& result, int row)
+                  : result_(&result), row_(row) {}
+
+  template <typename T>
+  T As(const int& index) const;
+
+  template <typename T>
+  T As(const std::string& column_name) const {
+    return As<T>(PgFieldReader::ColumnIndex(*result_, column_name));
+  }
+
+  /// @brief Non-throwing As<T>, see RowResult::TryAs.
+  template <typename T>
+  std::optional<T> TryAs(const int& index,
+                         FieldStatus* status = nullptr) const;
+
+  template <typename T>
+  std::optional<T> TryAs(const std::string& column_name,
+                         FieldStatus* status = nullptr) const;
+
+  bool IsNull(const int& index) const {
+    return PgFieldReader::IsNull(*result_, row_, index);
+  }
+
+  bool IsNull(const std::string& column_name) const {
+    return IsNull(PgFieldReader::ColumnIndex(*result_, column_name));
+  }
+
+  std::string_view AsStringView(const int& index) const {
+    return PgFieldReader::StringView(*result_, row_, index);
+  }
+
+  std::string_view AsStringView(const std::string& column_name) const {
+    return AsStringView(PgFieldReader::ColumnIndex(*result_, column_name));
+  }
+
+  BytesView AsBytes(const int& index) const {
+    return PgFieldReader::Bytes(*result_, row_, index);
+  }
+
+  BytesView AsBytes(const std::string& column_name) const {
+    return AsBytes(PgFieldReader::ColumnIndex(*result_, column_name));
+  }
+
+  template <typename T>
+  T AsDateTimeOffset(const int& index) const;
+
+  template <typename T>
+  T AsDateTimeOffset(const std::string& column_name) const {
+    return AsDateTimeOffset<T>(
+        PgFieldReader::ColumnIndex(*result_, column_name));
+  }
+
+  template <typename T>
+  T AsDateTime(const int& index) const;
+
+  template <typename T>
+  T AsDateTime(const std::string& column_name) const {
+    return AsDateTime<T>(PgFieldReader::ColumnIndex(*result_, column_name));
+  }
+
+  size_t Size() const {
+    return static_cast<size_t>(result_->Columns());
+  }
+
+  /// @brief Row offset in the result.
+  int Index() const {
+    return row_;
+  }
+
+ private:
+  const PgResultSet* result_;
+  int row_;
+};
+
+/// @brief Rows of a postgres result as PgRowView, iterator categories
+/// like RowViewRange (input, random-access concept in C++20).
+class PgRowViewRange {
+ public:
+  explicit PgRowViewRange(const PgResultSet& result);
+
+  /// @brief Rows of ExecutionResult created by the postgres driver,
+  /// throws std::invalid_argument for other drivers.
+  explicit PgRowViewRange(const ExecutionResult& result);
+
+  class Iterator {
+   public:
+    // operator* returns by value, see RowViewRange
+    using iterator_category = std::input_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = std::random_access_iterator_tag;
+#endif
+    using value_type = PgRowView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = PgRowView;
+
+    Iterator() : result_(nullptr), row_(0) {}
+
+    explicit Iterator(const PgResultSet& result, int row)
+                    : result_(&result), row_(row) {}
+
+    Iterator& operator++() {
+      ++row_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy = *this;
+      ++row_;
+      return copy;
+    }
+
+    Iterator& operator--() {
+      --row_;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      auto copy = *this;
+      --row_;
+      return copy;
+    }
+
+    Iterator& operator+=(difference_type n) {
+      row_ += static_cast<int>(n);
+      return *this;
+    }
+
+    Iterator& operator-=(difference_type n) {
+      row_ -= static_cast<int>(n);
+      return *this;
+    }
+
+    Iterator operator+(difference_type n) const {
+      auto copy = *this;
+      copy += n;
+      return copy;
+    }
+
+    Iterator operator-(difference_type n) const {
+      auto copy = *this;
+      copy -= n;
+      return copy;
+    }
+
+    difference_type operator-(const Iterator& other) const {
+      return static_cast<difference_type>(row_) - other.row_;
+    }
+
+    friend Iterator operator+(difference_type n, const Iterator& iter) {
+      return iter + n;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return result_ == other.result_ && row_ == other.row_;
+    }
+
+    bool operator!=(const Iterator& other) const {
+      return !(*this == other);
+    }
+
+    bool operator<(const Iterator& other) const {
+      return row_ < other.row_;
+    }
+
+    bool operator>(const Iterator& other) const {
+      return other < *this;
+    }
+
+    bool operator<=(const Iterator& other) const {
+      return !(other < *this);
+    }
+
+    bool operator>=(const Iterator& other) const {
+      return !(*this < other);
+    }
+
+    PgRowView operator*() const {
+      return PgRowView(*result_, row_);
+    }
+
+    PgRowView operator[](difference_type n) const {
+      return PgRowView(*result_, row_ + static_cast<int>(n));
+    }
+
+   private:
+    const PgResultSet* result_;
+    int row_;
+  };
+
+  Iterator begin() const {
+    return Iterator(*result_, 0);
+  }
+
+  Iterator end() const {
+    return Iterator(*result_, result_->Rows());
+  }
+
+  int Size() const {
+    return result_->Rows();
+  }
+
+ private:
+  const PgResultSet* result_;
+};
+
+template <typename T>
+T PgRowView::As(const int& index) const {
+  if constexpr (is_type_v<T, int64_t>) {
+    return PgFieldReader::Int64(*result_, row_, index);
+  } else if constexpr (is_type_v<T, int32_t>) {
+    return PgFieldReader::Int32(*result_, row_, index);
+  } else if constexpr (is_type_v<T, int16_t>) {
+    return PgFieldReader::Int16(*result_, row_, index);
+  } else if constexpr (is_type_v<T, float>) {
+    return PgFieldReader::Float(*result_, row_, index);
+  } else if constexpr (is_type_v<T, double>) {
+    return PgFieldReader::Double(*result_, row_, index);
+  } else if constexpr (is_type_v<T, std::string>) {
+    return PgFieldReader::String(*result_, row_, index);
+  } else if constexpr (is_type_v<T, std::vector<int16_t>>) {
+    return PgFieldReader::Array<int16_t>(*result_, row_, index);
+  } else if constexpr (is_type_v<T, std::vector<int32_t>>) {
+    return PgFieldReader::Array<int32_t>(*result_, row_, index);
+  } else if constexpr (is_type_v<T, std::vector<int64_t>>) {
+    return PgFieldReader::Array<int64_t>(*result_, row_, index);
+  } else if constexpr (is_type_v<T, std::vector<float>>) {
+    return PgFieldReader::Array<float>(*result_, row_, index);
+  } else if constexpr (is_type_v<T, std::vector<double>>) {
+    return PgFieldReader::Array<double>(*result_, row_, index);
+  } else if constexpr (is_type_v<T, std::vector<std::string>>) {
+    return PgFieldReader::Array<std::string>(*result_, row_, index);
+  } else {
+    static_assert(is_type_v<T, int64_t>,
+                  "PgRowView.As<T>, T is not supported by NvQL");
+  }
+}
+
+template <typename T>
+std::optional<T> PgRowView::TryAs(const int& index,
+                                  FieldStatus* status) const {
+  T value{};
+  FieldStatus result;
+  if constexpr (is_type_v<T, int64_t>) {
+    result = PgFieldReader::TryInt64(*result_, row_, index, value);
+  } else if constexpr (is_type_v<T, int32_t>) {
+    result = PgFieldReader::TryInt32(*result_, row_, index, value);
+  } else if constexpr (is_type_v<T, int16_t>) {
+    result = PgFieldReader::TryInt16(*result_, row_, index, value);
+  } else if constexpr (is_type_v<T, float>) {
+    result = PgFieldReader::TryFloat(*result_, row_, index, value);
+  } else if constexpr (is_type_v<T, double>) {
+    result = PgFieldReader::TryDouble(*result_, row_, index, value);
+  } else if constexpr (is_type_v<T, std::string>) {
+    result = PgFieldReader::TryString(*result_, row_, index, value);
+  } else {
+    static_assert(is_type_v<T, int64_t>,
+                  "PgRowView.TryAs<T>, T is not supported by NvQL");
+  }
+
+  if (status) {
+    *status = result;
+  }
+  if (result != FieldStatus::Ok) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+template <typename T>
+std::optional<T> PgRowView::TryAs(const std::string& column_name,
+                                  FieldStatus* status) const {
+  auto index = result_->ColumnNumber(column_name);
+  if (index < 0) {
+    if (status) {
+      *status = FieldStatus::UnknownColumn;
+    }
+    return std::nullopt;
+  }
+  return TryAs<T>(index, status);
+}
+
+template <typename T>
+T PgRowView::AsDateTimeOffset(const int& index) const {
+  if constexpr (is_type_v<T, nvm::dates::DateTime>) {
+    return PgFieldReader::Timestampz(*result_, row_, index);
+  } else {
+    static_assert(is_type_v<T, int64_t>,
+                  "PgRowView.AsDateTimeOffset<T>, T is not supported by NvQL");
+  }
+}
+
+template <typename T>
+T PgRowView::AsDateTime(const int& index) const {
+  if constexpr (is_type_v<T, nvm::dates::DateTime>) {
+    return PgFieldReader::Timestamp(*result_, row_, index);
+  } else {
+    static_assert(is_type_v<T, int64_t>,
+                  "PgRowView.AsDateTime<T>, T is not supported by NvQL");
+  }
+}
+
+NVSERV_END_NAMESPACE
+
+#if NVQL_SINGLE_DRIVER
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/// @brief Postgres is the only driver, every ExecutionResult is a
+/// PgExecutionResult, typed rows resolve to the devirtualized views.
+using NativeRowView = postgres::PgRowView;
+using NativeRowRange = postgres::PgRowViewRange;
+
+NVSERV_END_NAMESPACE
+#endif
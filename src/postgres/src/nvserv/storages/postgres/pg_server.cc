@@ -21,6 +21,9 @@
 
 #include "nvserv/storages/postgres/pg_server.h"
 
+#include <algorithm>
+#include <fstream>
+
 NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
 #if not defined(NVQL_STANDALONE) || NVQL_STANDALONE == 0
@@ -31,7 +34,9 @@ PgServer::PgServer(const components::ComponentLocator& locator,
                                 components::ComponentType::kPostgresFeature),
                   configs_(
                       static_cast<const postgres::PgStorageConfig&>(config)),
-                  pools_(CreatePools()) {};
+                  pools_(CreatePools()),
+                  task_pool_(CreateTaskPool()),
+                  binary_format_(false) {};
 
 PgServer::PgServer(const std::string& name,
                    std::initializer_list<PgClusterConfig> clusters,
@@ -41,7 +46,9 @@ PgServer::PgServer(const std::string& name,
                   configs_storage_(
                       CreateConfig(clusters, pool_min_worker, pool_max_worker)),
                   configs_(*configs_storage_),
-                  pools_(CreatePools()) {}
+                  pools_(CreatePools()),
+                  task_pool_(CreateTaskPool()),
+                  binary_format_(false) {}
 #endif
 
 #if defined(NVQL_STANDALONE) && NVQL_STANDALONE == 1
@@ -52,7 +59,9 @@ PgServer::PgServer(const std::string& name,
                   name_(std::string(name)),
                   configs_(
                       CreateConfig(clusters, pool_min_worker, pool_max_worker)),
-                  pools_(CreatePools()) {}
+                  pools_(CreatePools()),
+                  task_pool_(CreateTaskPool()),
+                  binary_format_(false) {}
 #endif
 
 PgServer::~PgServer() {}
@@ -63,18 +72,139 @@ const std::string& PgServer::Name() const {
 
 bool PgServer::TryConnect() {
   pools_->Run();
+  if (reactor_) {
+    reactor_->Start();
+  }
+  if (multiplexer_) {
+    multiplexer_->Start();
+  }
   return true;
 }
 
 bool PgServer::Shutdown(bool grace_shutdown, std::chrono::seconds deadline) {
+  if (reactor_) {
+    reactor_->Stop();
+  }
+  if (multiplexer_) {
+    multiplexer_->Stop();
+  }
   pools_->Stop();
   return false;
 }
 
 TransactionPtr PgServer::Begin(TransactionMode mode) {
+  if (mode == TransactionMode::NonTransaction && multiplexer_) {
+    return std::make_shared<PgMultiplexedTransaction>(multiplexer_,
+                                                      task_pool_);
+  }
   return std::move(std::make_shared<PgTransaction>(this, mode));
 }
 
+std::future<TransactionPtr> PgServer::BeginAsync(TransactionMode mode) {
+  return storages::impl::SubmitToTaskPool(
+      task_pool_, StorageType::Postgres, [this, mode]() { return Begin(mode); });
+}
+
+ExecutionResultPtr PgServer::Execute(const __NR_STRING_COMPAT_REF query,
+                                     const parameters::ParamView& args) {
+  PgTransaction tx(this, TransactionMode::AutoCommit);
+  return tx.ExecuteSync(query, args, true);
+}
+
+StatementHandle PgServer::Prepare(
+    const __NR_STRING_COMPAT_REF query,
+    const std::vector<parameters::DataType>& types) {
+  if (query.empty()) {
+    throw StorageException("Prepare on empty sql query",
+                           StorageType::Postgres);
+  }
+
+  std::vector<uint32_t> oids;
+  oids.reserve(types.size());
+  for (const auto& type : types) {
+    oids.push_back(impl::ToPgTypeOid(type));
+  }
+
+  const auto& catalog = pools_->StatementCatalog();
+  return StatementHandle(catalog.get(), catalog->Intern(query),
+                         std::move(oids));
+}
+
+const nvm::threads::TaskPoolPtr& PgServer::TaskPool() const {
+  return task_pool_;
+}
+
+void PgServer::EnableReactor(uint16_t threads) {
+  if (pools_->IsRun()) {
+    throw StorageException("EnableReactor must be called before TryConnect",
+                           StorageType::Postgres);
+  }
+  reactor_ = std::make_shared<PgReactor>(threads);
+}
+
+const PgReactorPtr& PgServer::Reactor() const {
+  return reactor_;
+}
+
+void PgServer::EnableMultiplexing(uint16_t connections) {
+  if (pools_->IsRun()) {
+    throw StorageException(
+        "EnableMultiplexing must be called before TryConnect",
+        StorageType::Postgres);
+  }
+  if (!reactor_) {
+    EnableReactor();
+  }
+  multiplexer_ = std::make_shared<PgMultiplexer>(pools_, reactor_, connections);
+  multiplexer_->SetBinaryFormat(binary_format_);
+}
+
+const PgMultiplexerPtr& PgServer::Multiplexer() const {
+  return multiplexer_;
+}
+
+void PgServer::EnableBinaryFormat(bool enabled) {
+  binary_format_ = enabled;
+  if (multiplexer_) {
+    multiplexer_->SetBinaryFormat(enabled);
+  }
+}
+
+bool PgServer::IsBinaryFormat() const {
+  return binary_format_;
+}
+
+StatementHandle PgServer::Warmup(
+    const __NR_STRING_COMPAT_REF query,
+    const std::vector<parameters::DataType>& types) {
+  auto handle = Prepare(query, types);
+  pools_->StatementCatalog()->AddWarmup(handle.Id(), handle.ParamTypes());
+  return handle;
+}
+
+size_t PgServer::LoadWarmupManifest(const std::string& path) {
+  std::ifstream manifest(path);
+  if (!manifest.is_open()) {
+    throw StorageException("Unable to open warm-up manifest: " + path,
+                           StorageType::Postgres);
+  }
+
+  size_t registered = 0;
+  std::string line;
+  while (std::getline(manifest, line)) {
+    auto first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line.compare(first, 2, "--") == 0) {
+      continue;
+    }
+    auto last = line.find_last_not_of(" \t\r");
+
+    Warmup(line.substr(first, last - first + 1));
+    registered++;
+  }
+
+  return registered;
+}
+
 const StorageConfig& PgServer::Configs() const {
   return configs_;
 }
@@ -158,12 +288,31 @@ ConnectionPoolPtr PgServer::CreatePools() {
   auto pools = std::make_shared<ConnectionPool>(name_, configs_);
 #endif
 
-  pools_->SetPrimaryConnectionCallback(PgServer::CreatePrimaryPgConnection);
-  pools_->SetStandbyConnectionCallback(PgServer::CreateStandbyPgConnection);
+  pools->SetPrimaryConnectionCallback(PgServer::CreatePrimaryPgConnection);
+  pools->SetStandbyConnectionCallback(PgServer::CreateStandbyPgConnection);
 
   return std::move(pools);
 }
 
+nvm::threads::TaskPoolPtr PgServer::CreateTaskPool() {
+  // TaskPool supplied from config always win
+  if (configs_.TaskPool()) {
+    return configs_.TaskPool();
+  }
+
+  if (configs_.TaskPoolOption() == TaskPoolMode::None) {
+    return nullptr;
+  }
+
+  // Each in-flight execution occupied one worker & one connection,
+  // more workers than connections only end-up waiting on the pool.
+  size_t workers = std::max(configs_.PoolConfig().MinConnection(),
+                            configs_.PoolConfig().MaxConnection());
+  workers = workers == 0 ? ConnectionPool::DEFAULT_WORKER_MINIMAL : workers;
+
+  return std::make_shared<nvm::threads::TaskPool>(workers);
+}
+
 // static
 ConnectionPtr PgServer::CreatePrimaryPgConnection(const std::string& name,
                                                   const StorageConfig* config) {
@@ -190,6 +339,37 @@ ConnectionPtr PgServer::CreateStandbyPgConnection(const std::string& name,
 
 // Late declare
 
+// static
+PgReactorPtr PgTransaction::GetReactor(PgServer* server) {
+  if (!server) {
+    return nullptr;
+  }
+  return server->Reactor();
+}
+
+// static
+QueryWatchdogPtr PgTransaction::GetWatchdog(PgServer* server) {
+  if (!server) {
+    throw storages::TransactionException(
+        "PgServer is Null, Unable to get query watchdog",
+        StorageType::Postgres);
+  }
+  return server->Pool()->Watchdog();
+}
+
+// static
+nvm::threads::TaskPoolPtr PgTransaction::GetTaskPool(PgServer* server) {
+  if (!server) {
+    return nullptr;
+  }
+  return server->TaskPool();
+}
+
+// static
+bool PgTransaction::IsBinaryFormat(PgServer* server) {
+  return server != nullptr && server->IsBinaryFormat();
+}
+
 std::shared_ptr<PgConnection> PgTransaction::GetConnectionFromPool() {
   if (!server_) {
     throw storages::TransactionException(
@@ -208,10 +388,34 @@ std::shared_ptr<PgConnection> PgTransaction::GetConnectionFromPool() {
 
 void PgTransaction::ReturnConnectionToThePool() {
   if (server_ != nullptr && connection_ != nullptr) {
+    ApplyAsyncFailures();
+
+    // Session statement_timeout must not leak into the next lease,
+    // SET LOCAL already ended with the block
+    if (server_timeout_.count() > 0 &&
+        inner_type_ == impl::PgInnerTransactionType::NonTransaction) {
+      auto result = PQexec(connection_->RawHandle(), "RESET statement_timeout");
+      if (result) {
+        PQclear(result);
+      }
+    }
+
     server_->Pool()->Return(connection_);
   }
 
-  server_ = nullptr;
+  server_timeout_ = std::chrono::milliseconds::zero();
+  connection_ = nullptr;
+}
+
+std::shared_ptr<void> PgTransaction::LeaseUntilReleased() {
+  auto pool = server_->Pool();
+  auto conn = connection_;
+  connection_ = nullptr;
+
+  // Deleter runs when the last holder released the lease
+  return std::shared_ptr<void>(nullptr, [pool, conn](void*) {
+    pool->Return(conn);
+  });
 }
 
 NVSERV_END_NAMESPACE
\ No newline at end of file
@@ -25,6 +25,8 @@
 #include "nvserv/storages/postgres/declare.h"
 #include "nvserv/storages/postgres/pg_cluster_config.h"
 #include "nvserv/storages/postgres/pg_connection.h"
+#include "nvserv/storages/postgres/pg_multiplexer.h"
+#include "nvserv/storages/postgres/pg_reactor.h"
 #include "nvserv/storages/postgres/pg_storage_config.h"
 #include "nvserv/storages/postgres/pg_transaction.h"
 #include "nvserv/storages/storage_config.h"
@@ -78,6 +80,61 @@ class PgServer final : public StorageServer {
   TransactionPtr Begin(
       TransactionMode mode) override;
 
+  std::future<TransactionPtr> BeginAsync(TransactionMode mode) override;
+
+  using StorageServer::Execute;
+
+  using StorageServer::Prepare;
+
+  StatementHandle Prepare(
+      const __NR_STRING_COMPAT_REF query,
+      const std::vector<parameters::DataType>& types) override;
+
+  ExecutionResultPtr Execute(const __NR_STRING_COMPAT_REF query,
+                             const parameters::ParamView& args) override;
+
+  const nvm::threads::TaskPoolPtr& TaskPool() const override;
+
+  /// @brief Execute async statements through non-blocking PgReactor
+  /// instead of occupying TaskPool worker per in-flight statement.
+  /// Must be called before TryConnect.
+  /// @param threads reactor threads, each drives many connections
+  void EnableReactor(uint16_t threads = PgReactor::DEFAULT_THREADS);
+
+  /// @brief Null when reactor is not enabled.
+  const PgReactorPtr& Reactor() const;
+
+  /// @brief Serve TransactionMode::NonTransaction from a few shared
+  /// connections, statements of all callers are pipelined into them.
+  /// Enables the reactor when not yet enabled.
+  /// Must be called before TryConnect.
+  /// @param connections connections leased permanently from the pool
+  void EnableMultiplexing(
+      uint16_t connections = PgMultiplexer::DEFAULT_CONNECTIONS);
+
+  /// @brief Null when multiplexing is not enabled.
+  const PgMultiplexerPtr& Multiplexer() const;
+
+  /// @brief Send parameters and receive results in postgres binary format
+  /// (int2/4/8, float4/8, bool, timestamp, bytea, uuid), skipping the
+  /// text formatting & parsing on both sides. Statements are executed
+  /// through libpq directly. Applies to transactions begun afterwards.
+  void EnableBinaryFormat(bool enabled = true);
+
+  bool IsBinaryFormat() const;
+
+  /// @brief Prepare the statement on every connection when it is opened,
+  /// so the first execution after deploy or reconnect skips PREPARE.
+  /// Register before TryConnect to cover the initial connections.
+  StatementHandle Warmup(const __NR_STRING_COMPAT_REF query,
+                         const std::vector<parameters::DataType>& types = {});
+
+  /// @brief Register the warm-up statements of a manifest file,
+  /// one statement per line, empty lines and `--` comments are skipped.
+  /// Statement text must match the executed query exactly.
+  /// @return number of statements registered
+  size_t LoadWarmupManifest(const std::string& path);
+
   const StorageConfig& Configs() const override;
 
   const PgStorageConfig& PgConfigs() const;
@@ -105,6 +162,10 @@ class PgServer final : public StorageServer {
 #endif
 
   ConnectionPoolPtr pools_;
+  nvm::threads::TaskPoolPtr task_pool_;
+  PgReactorPtr reactor_;
+  PgMultiplexerPtr multiplexer_;
+  bool binary_format_;
 
 #if defined(NVQL_STANDALONE) && NVQL_STANDALONE == 1
   PgStorageConfig CreateConfig(const std::vector<PgClusterConfig>& clusters,
@@ -120,6 +181,8 @@ class PgServer final : public StorageServer {
 
   ConnectionPoolPtr CreatePools();
 
+  nvm::threads::TaskPoolPtr CreateTaskPool();
+
   static ConnectionPtr CreatePrimaryPgConnection(const std::string& name,
                                                  const StorageConfig* config);
 
@@ -29,7 +29,8 @@ PgStorageConfig::PgStorageConfig(ClusterConfigList&& cluster_config,
                       StorageType::Postgres,
                       TransactionMode::ReadCommitted |
                           TransactionMode::ReadOnly |
-                          TransactionMode::ReadWrite,
+                          TransactionMode::ReadWrite |
+                          TransactionMode::AutoCommit,
                       true, std::forward<ConnectionPoolConfig>(pool_config),
                       TaskPoolMode::Internal, nullptr,
                       ConnectionMode::ServerCluster,
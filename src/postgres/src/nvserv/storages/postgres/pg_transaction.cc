@@ -33,13 +33,13 @@ PgInnerTransactionBase::~PgInnerTransactionBase() {
 
 ExecutionResultPtr PgInnerTransactionBase::Execute(
     const __NR_STRING_COMPAT_REF query_key,
-    const parameters::ParameterArgs& args) {
+    const parameters::ParamView& args) {
   throw nvserv::storages::UnsupportedFeatureException("Unimplemented Execute",
                                                       StorageType::Postgres);
 }
 
 ExecutionResultPtr PgInnerTransactionBase::ExecuteNonPrepared(
-    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
+    const __NR_STRING_COMPAT_REF query, const parameters::ParamView& args) {
   throw nvserv::storages::UnsupportedFeatureException("Unimplemented Execute",
                                                       StorageType::Postgres);
 }
@@ -62,53 +62,6 @@ PgInnerTransactionBase::PgInnerTransactionBase(pqxx::connection* conn,
                                                PgInnerTransactionType type)
                 : conn_(conn), type_(type) {};
 
-/** PgWorkTransaction */
-
-PgWorkTransaction::PgWorkTransaction(pqxx::connection* conn)
-                : PgInnerTransactionBase(conn,
-                                         PgInnerTransactionType::ReadWrite),
-                  txn_(CreateTransaction()) {}
-
-ExecutionResultPtr PgWorkTransaction::Execute(
-    const __NR_STRING_COMPAT_REF query_key,
-    const parameters::ParameterArgs& args) {
-  if (args.empty() ) {
-    auto result = txn_.exec_prepared(__NR_CALL_STRING_COMPAT_REF(query_key));
-    return std::move(std::make_shared<PgExecutionResult>(std::move(result)));
-  } else {
-    pqxx::params params;
-    TranslateParams(params, args);
-    auto result =
-        txn_.exec_prepared(__NR_CALL_STRING_COMPAT_REF(query_key), params);
-    return std::move(std::make_shared<PgExecutionResult>(std::move(result)));
-  }
-}
-
-ExecutionResultPtr PgWorkTransaction::ExecuteNonPrepared(
-    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
-  if (args.empty()) {
-    auto result = txn_.exec(__NR_CALL_STRING_COMPAT_REF(query));
-    return std::move(std::make_shared<PgExecutionResult>(std::move(result)));
-  } else {
-    pqxx::params params;
-    TranslateParams(params, args);
-    auto result = txn_.exec_params(__NR_CALL_STRING_COMPAT_REF(query), params);
-    return std::move(std::make_shared<PgExecutionResult>(std::move(result)));
-  }
-}
-
-void PgWorkTransaction::Commit() {
-  txn_.commit();
-}
-
-void PgWorkTransaction::Rollback() {
-  txn_.abort();
-}
-
-pqxx::work PgWorkTransaction::CreateTransaction() {
-  return pqxx::work(*conn_);
-}
-
 /* PgNonTransaction */
 
 PgNonTransaction::PgNonTransaction(pqxx::connection* conn)
@@ -118,7 +71,7 @@ PgNonTransaction::PgNonTransaction(pqxx::connection* conn)
 
 ExecutionResultPtr PgNonTransaction::Execute(
     const __NR_STRING_COMPAT_REF query_key,
-    const parameters::ParameterArgs& args) {
+    const parameters::ParamView& args) {
   if (args.empty()) {
     auto result = txn_.exec_prepared(__NR_CALL_STRING_COMPAT_REF(query_key));
     return std::move(std::make_shared<PgExecutionResult>(std::move(result)));
@@ -132,7 +85,7 @@ ExecutionResultPtr PgNonTransaction::Execute(
 }
 
 ExecutionResultPtr PgNonTransaction::ExecuteNonPrepared(
-    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
+    const __NR_STRING_COMPAT_REF query, const parameters::ParamView& args) {
   if (args.empty()) {
     auto result = txn_.exec(__NR_CALL_STRING_COMPAT_REF(query));
     return std::move(std::make_shared<PgExecutionResult>(std::move(result)));
@@ -156,16 +109,31 @@ pqxx::nontransaction PgNonTransaction::CreateTransaction() {
   return pqxx::nontransaction(*conn_);
 }
 
-/* PgReadOnlyTransaction */
+/* PgDeferredTransaction */
 
-PgReadOnlyTransaction::PgReadOnlyTransaction(pqxx::connection* conn)
-                : PgInnerTransactionBase(conn,
-                                         PgInnerTransactionType::ReadOnly),
-                  txn_(CreateTransaction()) {};
+PgDeferredTransaction::PgDeferredTransaction(pqxx::connection* conn,
+                                             PGconn* raw,
+                                             PgInnerTransactionType type)
+                : PgInnerTransactionBase(conn, type),
+                  raw_(raw),
+                  is_open_(true),
+                  txn_(pqxx::nontransaction(*conn_)) {}
 
-ExecutionResultPtr PgReadOnlyTransaction::Execute(
+PgDeferredTransaction::~PgDeferredTransaction() {
+  if (!is_open_) {
+    return;
+  }
+
+  try {
+    EndBlock("ROLLBACK");
+  } catch (...) {
+    // Connection is broken, nothing to rollback
+  }
+}
+
+ExecutionResultPtr PgDeferredTransaction::Execute(
     const __NR_STRING_COMPAT_REF query_key,
-    const parameters::ParameterArgs& args) {
+    const parameters::ParamView& args) {
   if (args.empty()) {
     auto result = txn_.exec_prepared(__NR_CALL_STRING_COMPAT_REF(query_key));
     return std::move(std::make_shared<PgExecutionResult>(std::move(result)));
@@ -178,8 +146,8 @@ ExecutionResultPtr PgReadOnlyTransaction::Execute(
   }
 }
 
-ExecutionResultPtr PgReadOnlyTransaction::ExecuteNonPrepared(
-    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
+ExecutionResultPtr PgDeferredTransaction::ExecuteNonPrepared(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParamView& args) {
   if (args.empty()) {
     auto result = txn_.exec(__NR_CALL_STRING_COMPAT_REF(query));
     return std::move(std::make_shared<PgExecutionResult>(std::move(result)));
@@ -191,16 +159,59 @@ ExecutionResultPtr PgReadOnlyTransaction::ExecuteNonPrepared(
   }
 }
 
-void PgReadOnlyTransaction::Commit() {
-  txn_.commit();
+void PgDeferredTransaction::Commit() {
+  if (!is_open_) {
+    return;
+  }
+
+  // Server answers COMMIT of an aborted block with ROLLBACK tag
+  if (EndBlock("COMMIT") != "COMMIT") {
+    throw TransactionException(
+        "Transaction was aborted by an earlier failed statement",
+        StorageType::Postgres);
+  }
+}
+
+void PgDeferredTransaction::Rollback() {
+  if (!is_open_) {
+    return;
+  }
+
+  EndBlock("ROLLBACK");
 }
 
-void PgReadOnlyTransaction::Rollback() {
-  txn_.abort();
+// static
+const char* PgDeferredTransaction::BeginCommand(PgInnerTransactionType type) {
+  switch (type) {
+    case PgInnerTransactionType::ReadWrite:
+      return "BEGIN";
+    case PgInnerTransactionType::ReadOnly:
+      return "BEGIN READ ONLY";
+    default:
+      throw TransactionException("Unsupported deferred transaction type",
+                                 StorageType::Postgres);
+  }
 }
 
-pqxx::read_transaction PgReadOnlyTransaction::CreateTransaction() {
-  return pqxx::read_transaction(*conn_);
+// private:
+
+std::string PgDeferredTransaction::EndBlock(const char* command) {
+  is_open_ = false;
+
+  auto result = PQexec(raw_, command);
+  if (!result) {
+    throw ConnectionException(PQerrorMessage(raw_), StorageType::Postgres);
+  }
+
+  if (PQresultStatus(result) != PGRES_COMMAND_OK) {
+    std::string error = PQresultErrorMessage(result);
+    PQclear(result);
+    throw ExecutionException(error, StorageType::Postgres);
+  }
+
+  std::string tag = PQcmdStatus(result);
+  PQclear(result);
+  return tag;
 }
 
 }  // namespace impl
@@ -230,17 +241,40 @@ pqxx::read_transaction PgReadOnlyTransaction::CreateTransaction() {
 /* PgTransaction */
 
 PgTransaction::PgTransaction(PgServer* server, TransactionMode mode)
-                : Transaction(StorageType::Postgres, mode),
+                : Transaction(StorageType::Postgres, mode, GetTaskPool(server)),
                   server_(server),
-                  connection_(GetConnectionFromPool()),
-                  transact_(CreateTransaction()) {}
+                  connection_(nullptr),
+                  transact_(nullptr),
+                  inner_type_(ToInnerTransactionType(mode)),
+                  begin_pending_(false),
+                  binary_format_(IsBinaryFormat(server)),
+                  server_timeout_(std::chrono::milliseconds::zero()),
+                  inflight_(0) {}
 
 PgTransaction::~PgTransaction() {
+  // finish the driver transaction before the connection
+  // can be leased by someone else
+  transact_.reset();
+
   // must be returned the borrowed connection from connection pool
   ReturnConnectionToThePool();
 }
 
-void PgTransaction::Commit() {
+// protected:
+
+void PgTransaction::CommitImpl() {
+  WaitAsyncIdle();
+
+  // Nothing executed, nothing to commit
+  if (!transact_) {
+    return;
+  }
+
+  // SET LOCAL ends with the block
+  if (inner_type_ != impl::PgInnerTransactionType::NonTransaction) {
+    server_timeout_ = std::chrono::milliseconds::zero();
+  }
+
   try {
     transact_->Commit();
   } catch (const std::exception& e) {
@@ -249,7 +283,17 @@ void PgTransaction::Commit() {
   }
 }
 
-void PgTransaction::Rollback() {
+void PgTransaction::RollbackImpl() {
+  WaitAsyncIdle();
+
+  if (!transact_) {
+    return;
+  }
+
+  if (inner_type_ != impl::PgInnerTransactionType::NonTransaction) {
+    server_timeout_ = std::chrono::milliseconds::zero();
+  }
+
   try {
     transact_->Rollback();
   } catch (const std::exception& e) {
@@ -258,51 +302,728 @@ void PgTransaction::Rollback() {
   }
 }
 
-// protected:
-
 ExecutionResultPtr PgTransaction::ExecuteImpl(
-    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
-  auto key = connection_->PrepareStatement(query);
-  if (!key.has_value()){
+    const __NR_STRING_COMPAT_REF query, const parameters::ParamView& args) {
+  WaitAsyncIdle();
+  Lease();
+  try {
+    ApplyServerTimeout();
+    auto result = WithDeadline(
+        [this, &query, &args]() { return Prepared(query, args); });
+    ReleaseAutoCommit();
+    return __NR_RETURN_MOVE(result);
+  } catch (...) {
+    // Failed statement must not keep the connection leased
+    ReleaseAutoCommit();
+    throw;
+  }
+}
+
+ExecutionResultPtr PgTransaction::ExecuteNonPreparedImpl(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParamView& args) {
+  if (query.empty()){
     throw TransactionException("Exceptions on empty sql query on Execute",
                                StorageType::Postgres);
   }
 
-  if (key.value().second){
-    connection_->Driver()->prepare(key.value().first,
-                                   __NR_CALL_STRING_COMPAT_REF(query));
+  WaitAsyncIdle();
+  Lease();
+  try {
+    ApplyServerTimeout();
+    auto result = WithDeadline(
+        [this, &query, &args]() { return NonPrepared(query, args); });
+    ReleaseAutoCommit();
+    return __NR_RETURN_MOVE(result);
+  } catch (...) {
+    // Failed statement must not keep the connection leased
+    ReleaseAutoCommit();
+    throw;
   }
+}
+
+ExecutionResultPtr PgTransaction::ExecuteImpl(
+    const StatementHandle& statement, const parameters::ParamView& args) {
+  WaitAsyncIdle();
+  Lease();
+  try {
+    auto manager = connection_->PreparedStatement();
+    if (manager->Catalog().get() != statement.Catalog()) {
+      throw TransactionException(
+          "StatementHandle was prepared by another PgServer",
+          StorageType::Postgres);
+    }
+    ApplyServerTimeout();
 
-  return std::move(transact_->Execute(key.value().first, args));
+    auto result = WithDeadline([&]() {
+      return Routed(statement.Id(), statement.Query(), statement.ParamTypes(),
+                    args);
+    });
+    ReleaseAutoCommit();
+    return __NR_RETURN_MOVE(result);
+  } catch (...) {
+    // Failed statement must not keep the connection leased
+    ReleaseAutoCommit();
+    throw;
+  }
 }
 
-ExecutionResultPtr PgTransaction::ExecuteNonPreparedImpl(
-    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
-  if (query.empty()){
+std::future<ExecutionResultPtr> PgTransaction::ExecuteAsyncImpl(
+    std::string query, parameters::ParameterArgs args, bool prepared,
+    std::shared_ptr<void> owner) {
+  auto reactor = GetReactor(server_);
+  if (!reactor) {
+    return Transaction::ExecuteAsyncImpl(std::move(query), std::move(args),
+                                         prepared, std::move(owner));
+  }
+
+  // Parameters are encoded below before returning, owner is not needed
+
+  if (query.empty()) {
     throw TransactionException("Exceptions on empty sql query on Execute",
                                StorageType::Postgres);
   }
 
-  return std::move(transact_->ExecuteNonPrepared(query, args));
+  if (!task_pool_) {
+    throw UnsupportedFeatureException(
+        "Async execution is disabled, no TaskPool configured "
+        "(TaskPoolMode::None)",
+        StorageType::Postgres);
+  }
+
+  // Submission order is the execution order on the connection
+  absl::MutexLock lock(&async_mutex_);
+  Lease();
+  ApplyAsyncFailures();
+
+  PgAsyncStatement statement;
+  if (!prepared) {
+    EncodeParams(statement, nullptr, args);
+  } else {
+    auto key = connection_->PrepareStatement(query);
+    if (!key.has_value()) {
+      throw TransactionException("Exceptions on empty sql query on Execute",
+                                 StorageType::Postgres);
+    }
+    const auto& catalog = connection_->PreparedStatement()->Catalog();
+    EncodeParams(statement,
+                 &impl::PreparedParamTypes(*catalog, key->Id(), {}, args,
+                                           binary_format_),
+                 args);
+    statement.name = key->Name();
+    statement.prepare = key->IsNew();
+
+    if (key->IsStale()) {
+      // Connection FIFO, dropped before it is prepared again
+      PgAsyncStatement deallocate;
+      deallocate.query = "DEALLOCATE " + key->Name();
+      deallocate.owner = AsyncOwner();
+      reactor->Submit(connection_, std::move(deallocate));
+    }
+
+    if (key->HasEvicted()) {
+      PgAsyncStatement deallocate;
+      deallocate.query = "DEALLOCATE " + key->EvictedName();
+      deallocate.owner = AsyncOwner();
+      deallocate.on_error = AsyncErrorHandler(
+          [victim = key->EvictedId()](PgConnection& conn,
+                                      const std::string& sqlstate, bool) {
+            conn.DeallocateFailed(victim, sqlstate);
+          });
+      reactor->Submit(connection_, std::move(deallocate));
+    }
+
+    statement.on_error = AsyncErrorHandler(
+        [id = key->Id()](PgConnection& conn, const std::string& sqlstate,
+                         bool prepare_failed) {
+          conn.PreparedStatementFailed(id, sqlstate, prepare_failed);
+        });
+  }
+
+  statement.query = std::move(query);
+
+  auto conn = connection_;
+  if (IsAutoCommit()) {
+    // connection goes back to the pool once the statement completed
+    transact_.reset();
+    statement.owner = LeaseUntilReleased();
+  } else {
+    // the connection must stay leased until the statement completed
+    statement.owner = AsyncOwner();
+  }
+
+  if (statement_timeout_.count() > 0) {
+    auto watchdog = GetWatchdog(server_);
+    auto deadline =
+        watchdog->Watch(statement_timeout_, conn->CancelCallback());
+
+    // Unwatch as soon as the statement finished, before the next statement
+    // on the connection is sent and before the owner (and the lease) goes.
+    statement.on_finish = [watchdog, deadline]() {
+      return watchdog->Unwatch(deadline);
+    };
+  }
+
+  if (!begin_pending_) {
+    auto timeout = ServerTimeoutCommand();
+    if (timeout.empty()) {
+      return reactor->Submit(std::move(conn), std::move(statement));
+    }
+
+    // SET & statement share the pipeline, no extra round trip
+    auto owner = statement.owner;
+    PgAsyncStatement set;
+    set.query = std::move(timeout);
+    set.owner = owner;
+    reactor->Submit(conn, std::move(set), true);
+    auto future = reactor->Submit(conn, std::move(statement), true);
+
+    if (IsAutoCommit()) {
+      // Session default restored before the lease goes back to the pool
+      PgAsyncStatement reset;
+      reset.query = "RESET statement_timeout";
+      reset.owner = std::move(owner);
+      reactor->Submit(std::move(conn), std::move(reset), true);
+    } else {
+      server_timeout_ = ServerTimeout();
+    }
+    return future;
+  }
+
+  // BEGIN & statement share the pipeline, no extra round trip
+  for (auto& begin : BeginStatements()) {
+    begin.owner = statement.owner;
+    reactor->Submit(conn, std::move(begin), true);
+  }
+  auto future = reactor->Submit(std::move(conn), std::move(statement), true);
+
+  begin_pending_ = false;
+  server_timeout_ = ServerTimeout();
+  transact_ = CreateTransaction();
+  return future;
 }
 
 // private:
 
+void PgTransaction::Lease() {
+  if (connection_) {
+    return;
+  }
+
+  connection_ = GetConnectionFromPool();
+  if (inner_type_ == impl::PgInnerTransactionType::NonTransaction) {
+    transact_ = CreateTransaction();
+  } else {
+    begin_pending_ = true;
+  }
+}
+
+std::shared_ptr<void> PgTransaction::AsyncOwner() {
+  {
+    absl::MutexLock lock(&inflight_mutex_);
+    inflight_++;
+  }
+
+  auto self = shared_from_this();
+  auto pool = task_pool_;
+  return std::shared_ptr<void>(nullptr, [self, pool](void*) mutable {
+    auto tx = static_cast<PgTransaction*>(self.get());
+    {
+      absl::MutexLock lock(&tx->inflight_mutex_);
+      tx->inflight_--;
+    }
+
+    // Might be the last reference, destroy it off the reactor thread
+    pool->ExecuteTask([self = std::move(self)]() mutable { self.reset(); });
+  });
+}
+
+void PgTransaction::WaitAsyncIdle() {
+  {
+    absl::MutexLock lock(&inflight_mutex_);
+    inflight_mutex_.Await(absl::Condition(
+        +[](int* inflight) { return *inflight == 0; }, &inflight_));
+  }
+
+  ApplyAsyncFailures();
+}
+
+std::function<void(const std::string&, bool)> PgTransaction::AsyncErrorHandler(
+    std::function<void(PgConnection&, const std::string&, bool)> apply) {
+  auto conn = connection_;
+  if (IsAutoCommit()) {
+    // Leased to the statement, no one else touches the connection
+    return [conn, apply](const std::string& sqlstate, bool prepare_failed) {
+      apply(*conn, sqlstate, prepare_failed);
+    };
+  }
+
+  // Kept alive by the statement owner until the handler returned
+  return [this, conn, apply](const std::string& sqlstate,
+                             bool prepare_failed) {
+    absl::MutexLock lock(&inflight_mutex_);
+    async_failures_.emplace_back([conn, apply, sqlstate, prepare_failed]() {
+      apply(*conn, sqlstate, prepare_failed);
+    });
+  };
+}
+
+void PgTransaction::ApplyAsyncFailures() {
+  std::vector<std::function<void()>> failures;
+  {
+    absl::MutexLock lock(&inflight_mutex_);
+    failures.swap(async_failures_);
+  }
+
+  for (auto& failure : failures) {
+    failure();
+  }
+}
+
+void PgTransaction::ReleaseAutoCommit() {
+  if (!IsAutoCommit()) {
+    return;
+  }
+
+  transact_.reset();
+  ReturnConnectionToThePool();
+}
+
+ExecutionResultPtr PgTransaction::ExecutePipelined(
+    PgAsyncStatement&& statement, const PreparedStatementKey* key) {
+  PgPipeline pipeline(connection_->RawHandle());
+  size_t first = 0;
+  if (key && key->HasEvicted()) {
+    // Prepared statements are not transactional, dropped even if the block
+    // is rolled back. Own sync segment: outside a block its failure doesn't
+    // skip the statement, inside an open block the server aborts it anyway.
+    PgAsyncStatement evicted;
+    evicted.query = "DEALLOCATE " + key->EvictedName();
+    pipeline.Add(std::move(evicted)).Sync();
+    first = 1;
+  }
+
+  bool with_begin = begin_pending_;
+  if (with_begin) {
+    for (auto& begin : BeginStatements()) {
+      pipeline.Add(std::move(begin));
+    }
+  }
+  pipeline.Add(std::move(statement));
+  auto results = pipeline.Run();
+
+  if (first > 0 && !results[0].Ok()) {
+    connection_->DeallocateFailed(key->EvictedId(), results[0].sqlstate);
+  }
+
+  // Skipped by a failed BEGIN too
+  const auto& last = results.back();
+  if (key && !last.Ok()) {
+    connection_->PreparedStatementFailed(key->Id(), last.sqlstate,
+                                         last.prepare_failed);
+  }
+
+  if (with_begin) {
+    if (!results[first].Ok()) {
+      // No block opened, the next execution retries BEGIN
+      throw TransactionException(
+          "Transaction Begin failed: " + results[first].error,
+          StorageType::Postgres);
+    }
+
+    begin_pending_ = false;
+    server_timeout_ = ServerTimeout();
+    transact_ = CreateTransaction();
+    first++;
+  }
+
+  for (size_t i = first; i < results.size(); i++) {
+    if (!results[i].Ok()) {
+      if (results[i].sqlstate == impl::PG_QUERY_CANCELED) {
+        throw QueryTimeoutException(results[i].error, StorageType::Postgres);
+      }
+      throw ExecutionException(results[i].error, StorageType::Postgres);
+    }
+  }
+
+  return std::make_shared<PgExecutionResult>(results.back().result);
+}
+
+ExecutionResultPtr PgTransaction::ExecuteDirect(
+    const char* name, const char* query,
+    const std::vector<uint32_t>* param_types,
+    const parameters::ParamView& args, std::optional<StatementId> id) {
+  auto raw = connection_->RawHandle();
+  auto& buffer = connection_->ParamBuffer();
+  buffer.Encode(args, param_types, true);
+
+  PGresult* result =
+      name ? PQexecPrepared(raw, name, buffer.Size(), buffer.Values(),
+                            buffer.Lengths(), buffer.Formats(), 1)
+           : PQexecParams(raw, query, buffer.Size(), buffer.Types(),
+                          buffer.Values(), buffer.Lengths(), buffer.Formats(),
+                          1);
+  if (!result) {
+    throw ConnectionException(PQerrorMessage(raw), StorageType::Postgres);
+  }
+
+  auto status = PQresultStatus(result);
+  if (status != PGRES_TUPLES_OK && status != PGRES_COMMAND_OK) {
+    std::string error = PQresultErrorMessage(result);
+    auto field = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+    std::string sqlstate = field ? field : "";
+    PQclear(result);
+
+    if (name && query && param_types && id.has_value() &&
+        sqlstate == impl::PG_STALE_PLAN &&
+        inner_type_ == impl::PgInnerTransactionType::NonTransaction) {
+      // Each statement is its own transaction, safe to retry once
+      try {
+        connection_->Driver()->unprepare(name);
+      } catch (...) {
+        // Still the stale plan on the server
+        connection_->PreparedStatement()->MarkStale(id.value());
+        throw;
+      }
+      PrepareOnServer(id.value(), name, query, *param_types);
+      return ExecuteDirect(name, nullptr, param_types, args, id);
+    }
+
+    if (id.has_value() && !sqlstate.empty()) {
+      connection_->PreparedStatementFailed(id.value(), sqlstate, false);
+    }
+    if (sqlstate == impl::PG_QUERY_CANCELED) {
+      // statement_timeout mirrored on the server fired
+      throw QueryTimeoutException(error, StorageType::Postgres);
+    }
+    throw ExecutionException(error, StorageType::Postgres);
+  }
+
+  return std::make_shared<PgExecutionResult>(
+      std::make_shared<const PgResultSet>(result));
+}
+
+bool PgTransaction::CanExecuteDirect() const {
+  return binary_format_ && !begin_pending_;
+}
+
+void PgTransaction::EncodeParams(PgAsyncStatement& statement,
+                                 const std::vector<uint32_t>* param_types,
+                                 const parameters::ParamView& args) const {
+  if (binary_format_) {
+    impl::TranslateBinaryParams(args, param_types, statement);
+    return;
+  }
+
+  if (param_types) {
+    statement.param_types = *param_types;
+  }
+  statement.values = impl::TranslateTextParams(args);
+}
+
+std::vector<PgAsyncStatement> PgTransaction::BeginStatements() const {
+  std::vector<PgAsyncStatement> statements(1);
+  statements[0].query = impl::PgDeferredTransaction::BeginCommand(inner_type_);
+
+  // Server enforces the deadline too, even if the client vanished
+  auto timeout = ServerTimeoutCommand();
+  if (!timeout.empty()) {
+    statements.emplace_back();
+    statements.back().query = std::move(timeout);
+  }
+
+  return statements;
+}
+
+std::chrono::milliseconds PgTransaction::ServerTimeout() const {
+  if (!server_side_timeout_ || statement_timeout_.count() <= 0) {
+    return std::chrono::milliseconds::zero();
+  }
+  return statement_timeout_;
+}
+
+std::string PgTransaction::ServerTimeoutCommand() const {
+  auto timeout = ServerTimeout();
+  if (timeout == server_timeout_) {
+    return std::string();
+  }
+
+  bool block = inner_type_ != impl::PgInnerTransactionType::NonTransaction;
+  if (timeout.count() > 0) {
+    return std::string(block ? "SET LOCAL" : "SET") +
+           " statement_timeout = " + std::to_string(timeout.count());
+  }
+
+  // Back to the server configured default
+  return block ? "SET LOCAL statement_timeout TO DEFAULT"
+               : "RESET statement_timeout";
+}
+
+void PgTransaction::ApplyServerTimeout() {
+  if (begin_pending_) {
+    return;
+  }
+
+  auto command = ServerTimeoutCommand();
+  if (command.empty()) {
+    return;
+  }
+
+  auto result = PQexec(connection_->RawHandle(), command.c_str());
+  if (!result) {
+    throw ConnectionException(PQerrorMessage(connection_->RawHandle()),
+                              StorageType::Postgres);
+  }
+
+  if (PQresultStatus(result) != PGRES_COMMAND_OK) {
+    std::string error = PQresultErrorMessage(result);
+    PQclear(result);
+    throw ExecutionException(error, StorageType::Postgres);
+  }
+  PQclear(result);
+
+  server_timeout_ = ServerTimeout();
+}
+
+template <typename TFunc>
+ExecutionResultPtr PgTransaction::WithDeadline(TFunc&& func) {
+  if (statement_timeout_.count() <= 0) {
+    return func();
+  }
+
+  auto watchdog = GetWatchdog(server_);
+  auto deadline =
+      watchdog->Watch(statement_timeout_, connection_->CancelCallback());
+
+  try {
+    auto result = func();
+    watchdog->Unwatch(deadline);
+    return __NR_RETURN_MOVE(result);
+  } catch (const std::exception& e) {
+    if (watchdog->Unwatch(deadline)) {
+      throw QueryTimeoutException(
+          "Statement cancelled, exceeded deadline of " +
+              std::to_string(statement_timeout_.count()) + "ms: " + e.what(),
+          StorageType::Postgres);
+    }
+
+    // statement_timeout mirrored on the server fired first
+    if (dynamic_cast<const pqxx::query_cancelled*>(&e)) {
+      throw QueryTimeoutException(e.what(), StorageType::Postgres);
+    }
+    throw;
+  }
+}
+
+ExecutionResultPtr PgTransaction::Prepared(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParamView& args) {
+  if (query.empty()) {
+    throw TransactionException("Exceptions on empty sql query on Execute",
+                               StorageType::Postgres);
+  }
+
+  // Parameter types recorded by the first PREPARE
+  static const std::vector<uint32_t> undeclared_types;
+  const auto& catalog = connection_->PreparedStatement()->Catalog();
+  auto id = catalog->Intern(query);
+  return Routed(id, catalog->Query(id), undeclared_types, args);
+}
+
+ExecutionResultPtr PgTransaction::Routed(
+    StatementId id, const std::string& query,
+    const std::vector<uint32_t>& param_types,
+    const parameters::ParamView& args) {
+  auto manager = connection_->PreparedStatement();
+  const auto& catalog = manager->Catalog();
+  auto plan = catalog->ChoosePlan(id);
+  auto started = std::chrono::steady_clock::now();
+
+  ExecutionResultPtr result;
+  if (plan == PlanChoice::NonPrepared) {
+    result = CanExecuteDirect()
+                 ? ExecuteDirect(nullptr, query.c_str(), nullptr, args)
+                 : NonPrepared(query, args);
+  } else {
+    // Same types on every connection, values of other types go as text
+    const auto& prepared_types = impl::PreparedParamTypes(
+        *catalog, id, param_types, args, binary_format_);
+    auto key = manager->Register(id);
+    result = Prepared(key, query, prepared_types, args);
+    if (key.IsNew()) {
+      // PREPARE round trip would skew the latency
+      return __NR_RETURN_MOVE(result);
+    }
+  }
+
+  catalog->RecordLatency(
+      id, plan,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - started));
+  return __NR_RETURN_MOVE(result);
+}
+
+ExecutionResultPtr PgTransaction::Prepared(
+    const PreparedStatementKey& key, const std::string& query,
+    const std::vector<uint32_t>& param_types,
+    const parameters::ParamView& args) {
+  if (key.IsStale()) {
+    try {
+      connection_->Driver()->unprepare(key.Name());
+    } catch (...) {
+      // Still the stale plan on the server
+      connection_->PreparedStatement()->MarkStale(key.Id());
+      throw;
+    }
+  }
+
+  if (CanExecuteDirect() && !key.IsNew() && !key.HasEvicted()) {
+    return ExecuteDirect(key.Name().c_str(), query.c_str(), &param_types,
+                         args, key.Id());
+  }
+
+  if (begin_pending_ || binary_format_) {
+    PgAsyncStatement statement;
+    statement.name = key.Name();
+    statement.query = query;
+    statement.prepare = key.IsNew();
+    EncodeParams(statement, &param_types, args);
+    return ExecutePipelined(std::move(statement), &key);
+  }
+
+  if (key.HasEvicted()) {
+    // Least recently used statement evicted by the connection capacity
+    try {
+      connection_->Driver()->unprepare(key.EvictedName());
+    } catch (const pqxx::sql_error& e) {
+      connection_->DeallocateFailed(key.EvictedId(), e.sqlstate());
+      if (key.IsNew()) {
+        connection_->PreparedStatement()->Forget(key.Id());
+      }
+      throw;
+    }
+  }
+
+  if (key.IsNew()) {
+    PrepareOnServer(key.Id(), key.Name(), query, param_types);
+  }
+
+  try {
+    return transact_->Execute(key.Name(), args);
+  } catch (const pqxx::feature_not_supported&) {
+    // Stale plan, e.g. "cached plan must not change result type"
+    // after schema changed.
+    if (inner_type_ != impl::PgInnerTransactionType::NonTransaction) {
+      // Block is aborted, re-prepare on the next use
+      connection_->PreparedStatement()->MarkStale(key.Id());
+      throw;
+    }
+
+    // Each statement is its own transaction, safe to retry once
+    connection_->Driver()->unprepare(key.Name());
+    PrepareOnServer(key.Id(), key.Name(), query, param_types);
+    return transact_->Execute(key.Name(), args);
+  } catch (const pqxx::sql_error& e) {
+    connection_->PreparedStatementFailed(key.Id(), e.sqlstate(), false);
+    throw;
+  }
+}
+
+void PgTransaction::PrepareOnServer(StatementId id, const std::string& name,
+                                    const std::string& query,
+                                    const std::vector<uint32_t>& param_types) {
+  if (param_types.empty()) {
+    try {
+      connection_->Driver()->prepare(name, query);
+    } catch (const pqxx::sql_error& e) {
+      connection_->PreparedStatementFailed(id, e.sqlstate(), true);
+      throw;
+    } catch (...) {
+      connection_->PreparedStatement()->Forget(id);
+      throw;
+    }
+    return;
+  }
+
+  // pqxx can't declare parameter types, prepare through libpq
+  auto result = PQprepare(connection_->RawHandle(), name.c_str(),
+                          query.c_str(), static_cast<int>(param_types.size()),
+                          param_types.data());
+  if (!result) {
+    connection_->PreparedStatement()->Forget(id);
+    throw ConnectionException(PQerrorMessage(connection_->RawHandle()),
+                              StorageType::Postgres);
+  }
+
+  if (PQresultStatus(result) != PGRES_COMMAND_OK) {
+    std::string error = PQresultErrorMessage(result);
+    auto sqlstate = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+    connection_->PreparedStatementFailed(id, sqlstate ? sqlstate : "", true);
+    PQclear(result);
+    throw ExecutionException(error, StorageType::Postgres);
+  }
+  PQclear(result);
+}
+
+ExecutionResultPtr PgTransaction::NonPrepared(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParamView& args) {
+  if (CanExecuteDirect()) {
+    std::string sql = __NR_CALL_STRING_COMPAT_REF(query);
+    return ExecuteDirect(nullptr, sql.c_str(), nullptr, args);
+  }
+
+  if (begin_pending_ || binary_format_) {
+    PgAsyncStatement statement;
+    statement.query = __NR_CALL_STRING_COMPAT_REF(query);
+    EncodeParams(statement, nullptr, args);
+    return ExecutePipelined(std::move(statement));
+  }
+
+  return transact_->ExecuteNonPrepared(query, args);
+}
+
 std::unique_ptr<impl::PgInnerTransactionBase>
 PgTransaction::CreateTransaction() {
-  switch (mode_) {
+  switch (inner_type_) {
+    case impl::PgInnerTransactionType::ReadWrite:
+    case impl::PgInnerTransactionType::ReadOnly:
+      return std::make_unique<impl::PgDeferredTransaction>(
+          connection_->Driver(), connection_->RawHandle(), inner_type_);
+    case impl::PgInnerTransactionType::NonTransaction:
+      return std::make_unique<impl::PgNonTransaction>(connection_->Driver());
+    default:
+      throw storages::TransactionException(
+          "Postgres unsupported Transaction Mode: " +
+              ToStringEnumTransactionMode(mode_),
+          StorageType::Postgres);
+  }
+}
+
+// static
+impl::PgInnerTransactionType PgTransaction::ToInnerTransactionType(
+    TransactionMode mode) {
+  // Implicit transaction, BEGIN/COMMIT are never sent
+  if ((mode & TransactionMode::AutoCommit) == TransactionMode::AutoCommit) {
+    // No BEGIN READ ONLY to carry it, refuse instead of writing silently
+    if ((mode & TransactionMode::ReadOnly) == TransactionMode::ReadOnly) {
+      throw storages::TransactionException(
+          "Postgres AutoCommit can't be ReadOnly: " +
+              ToStringEnumTransactionMode(mode),
+          StorageType::Postgres);
+    }
+    return impl::PgInnerTransactionType::NonTransaction;
+  }
+
+  switch (mode) {
     case TransactionMode::ReadWrite:
-      return std::make_unique<impl::PgWorkTransaction>(connection_->Driver());
+      return impl::PgInnerTransactionType::ReadWrite;
     case TransactionMode::ReadOnly:
     case TransactionMode::ReadCommitted:
-      return std::make_unique<impl::PgReadOnlyTransaction>(
-          connection_->Driver());
+      return impl::PgInnerTransactionType::ReadOnly;
     case TransactionMode::NonTransaction:
-      return std::make_unique<impl::PgNonTransaction>(connection_->Driver());
+      return impl::PgInnerTransactionType::NonTransaction;
     default:
       throw storages::TransactionException(
           "Postgres unsupported Transaction Mode: " +
-              ToStringEnumTransactionMode(mode_),
+              ToStringEnumTransactionMode(mode),
           StorageType::Postgres);
   }
 }
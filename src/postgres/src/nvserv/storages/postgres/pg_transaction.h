@@ -28,14 +28,19 @@
 #include "nvserv/global_macro.h"
 #include "nvserv/storages/connection_pool.h"
 #include "nvserv/storages/postgres/declare.h"
+#include "nvserv/storages/postgres/pg_binary.h"
 #include "nvserv/storages/postgres/pg_column.h"
 #include "nvserv/storages/postgres/pg_connection.h"
 #include "nvserv/storages/postgres/pg_execution_result.h"
+#include "nvserv/storages/postgres/pg_helper.h"
+#include "nvserv/storages/postgres/pg_pipeline.h"
+#include "nvserv/storages/postgres/pg_reactor.h"
 #include "nvserv/storages/transaction.h"
 
 NVSERV_BEGIN_NAMESPACE(storages::postgres)
 
 namespace impl {
+
 enum class PgInnerTransactionType {
   Unknown,
   ReadWrite,
@@ -44,8 +49,55 @@ enum class PgInnerTransactionType {
   SubTransaction
 };
 
+/// @brief Encode parameter as postgres text representation.
+inline std::string TranslateTextParam(const parameters::Param& param) {
+  using namespace parameters;
+  switch (param.Type()) {
+    case DataType::SmallInt:
+      return pqxx::to_string(param.As<int16_t>());
+    case DataType::Int:
+      return pqxx::to_string(param.As<int32_t>());
+    case DataType::BigInt:
+      return pqxx::to_string(param.As<int64_t>());
+    case DataType::Double:
+      return pqxx::to_string(param.As<double>());
+    case DataType::Real:
+      return pqxx::to_string(param.As<float>());
+    case DataType::String:
+      return param.As<std::string>();
+    case DataType::Boolean:
+      return param.As<bool>() ? "t" : "f";
+    case DataType::Timestamp:
+      return helper::FormatTimestamp(
+          param.As<std::chrono::system_clock::time_point>());
+    case DataType::Timestampz:
+      return param.As<NvDateTime>().ToIso8601();
+    case DataType::Bytea: {
+      const auto& bytes = param.As<std::vector<unsigned char>>();
+      return helper::FormatBytea(bytes.data(), bytes.size());
+    }
+    case DataType::Uuid:
+      return helper::FormatUuid(
+          param.As<std::array<unsigned char, 16>>().data());
+    case DataType::SmallIntArray:
+      return helper::FormatArray(param.As<std::vector<int16_t>>());
+    case DataType::IntArray:
+      return helper::FormatArray(param.As<std::vector<int32_t>>());
+    case DataType::BigIntArray:
+      return helper::FormatArray(param.As<std::vector<int64_t>>());
+    case DataType::RealArray:
+      return helper::FormatArray(param.As<std::vector<float>>());
+    case DataType::DoubleArray:
+      return helper::FormatArray(param.As<std::vector<double>>());
+    case DataType::StringArray:
+      return helper::FormatArray(param.As<std::vector<std::string>>());
+    default:
+      throw std::invalid_argument("Unsupported data type");
+  }
+}
+
 inline void TranslateParams(pqxx::params& params,
-                            const parameters::ParameterArgs& nvql_params) {
+                            const parameters::ParamView& nvql_params) {
   using namespace parameters;
   for (const auto& param : nvql_params) {
     switch (param.Type()) {
@@ -65,17 +117,26 @@ inline void TranslateParams(pqxx::params& params,
         params.append(param.As<float>());
         break;
       case DataType::String:
-        params.append(param.As<std::string>());
+        // pqxx keeps the view, no copy of the string
+        params.append(std::string_view(param.As<std::string>()));
         break;
       case DataType::Boolean:
         params.append(param.As<bool>());
         break;
-      // case DataType::Timestamp:
-      //   params.append(param.As<std::chrono::system_clock::time_point>());
-      //   break;
       case DataType::Timestampz:
         params.append(param.As<NvDateTime>().ToIso8601());
         break;
+      case DataType::Timestamp:
+      case DataType::Bytea:
+      case DataType::Uuid:
+      case DataType::SmallIntArray:
+      case DataType::IntArray:
+      case DataType::BigIntArray:
+      case DataType::RealArray:
+      case DataType::DoubleArray:
+      case DataType::StringArray:
+        params.append(TranslateTextParam(param));
+        break;
       // case DataType::Date:
       //   params.append(param.As<std::vector<unsigned char>>());
       //   break;
@@ -85,16 +146,244 @@ inline void TranslateParams(pqxx::params& params,
   }
 };
 
+/// @brief Postgres type OID of parameter type, 0 lets the server infer it.
+inline uint32_t ToPgTypeOid(parameters::DataType type) {
+  using namespace parameters;
+  switch (type) {
+    case DataType::SmallInt:
+      return 21;  // int2
+    case DataType::Int:
+      return 23;  // int4
+    case DataType::BigInt:
+      return 20;  // int8
+    case DataType::Real:
+      return 700;  // float4
+    case DataType::Double:
+      return 701;  // float8
+    case DataType::String:
+      return 25;  // text
+    case DataType::Boolean:
+      return 16;  // bool
+    case DataType::Date:
+      return 1082;  // date
+    case DataType::Time:
+      return 1083;  // time
+    case DataType::Timestamp:
+      return 1114;  // timestamp
+    case DataType::Timestampz:
+      return 1184;  // timestamptz
+    case DataType::Bytea:
+      return 17;  // bytea
+    case DataType::Uuid:
+      return 2950;  // uuid
+    case DataType::SmallIntArray:
+      return 1005;  // int2[]
+    case DataType::IntArray:
+      return 1007;  // int4[]
+    case DataType::BigIntArray:
+      return 1016;  // int8[]
+    case DataType::RealArray:
+      return 1021;  // float4[]
+    case DataType::DoubleArray:
+      return 1022;  // float8[]
+    case DataType::StringArray:
+      return 1009;  // text[]
+    default:
+      return 0;
+  }
+}
+
+/// @brief Encode parameters as postgres text representation,
+/// used by libpq direct executions (PgReactor).
+inline std::vector<std::string> TranslateTextParams(
+    const parameters::ParamView& nvql_params) {
+  std::vector<std::string> values;
+  values.reserve(nvql_params.size());
+
+  for (const auto& param : nvql_params) {
+    values.emplace_back(TranslateTextParam(param));
+  }
+
+  return values;
+}
+
+/// @brief Append parameter postgres text representation to `out`.
+inline void AppendTextParam(const parameters::Param& param, std::string& out) {
+  using namespace parameters;
+  switch (param.Type()) {
+    case DataType::String:
+      out.append(param.As<std::string>());
+      break;
+    case DataType::Boolean:
+      out.push_back(param.As<bool>() ? 't' : 'f');
+      break;
+    default:
+      out.append(TranslateTextParam(param));
+      break;
+  }
+}
+
+/// @brief Append parameter postgres binary representation to `out`.
+/// @return type OID of the binary value,
+/// 0 when the type has no binary encoding (the text is appended).
+inline uint32_t AppendBinaryParam(const parameters::Param& param,
+                                  std::string& out) {
+  using namespace parameters;
+  switch (param.Type()) {
+    case DataType::SmallInt:
+      out.append(helper::WriteInt16(param.As<int16_t>()));
+      return helper::oid::INT2;
+    case DataType::Int:
+      out.append(helper::WriteInt32(param.As<int32_t>()));
+      return helper::oid::INT4;
+    case DataType::BigInt:
+      out.append(helper::WriteInt64(param.As<int64_t>()));
+      return helper::oid::INT8;
+    case DataType::Double:
+      out.append(helper::WriteFloat8(param.As<double>()));
+      return helper::oid::FLOAT8;
+    case DataType::Real:
+      out.append(helper::WriteFloat4(param.As<float>()));
+      return helper::oid::FLOAT4;
+    case DataType::Boolean:
+      out.append(helper::WriteBool(param.As<bool>()));
+      return helper::oid::BOOL;
+    case DataType::Timestamp:
+      out.append(helper::WriteTimestamp(
+          param.As<std::chrono::system_clock::time_point>()));
+      return helper::oid::TIMESTAMP;
+    case DataType::Timestampz:
+      // timestamptz is stored as UTC, no ISO 8601 string needed
+      out.append(helper::WriteTimestamp(
+          param.As<NvDateTime>().TzTime()->get_sys_time()));
+      return helper::oid::TIMESTAMPTZ;
+    case DataType::Bytea: {
+      const auto& bytes = param.As<std::vector<unsigned char>>();
+      out.append(bytes.begin(), bytes.end());
+      return helper::oid::BYTEA;
+    }
+    case DataType::Uuid: {
+      const auto& bytes = param.As<std::array<unsigned char, 16>>();
+      out.append(bytes.begin(), bytes.end());
+      return helper::oid::UUID;
+    }
+    case DataType::SmallIntArray:
+      out.append(helper::WriteArray(param.As<std::vector<int16_t>>()));
+      return helper::oid::INT2_ARRAY;
+    case DataType::IntArray:
+      out.append(helper::WriteArray(param.As<std::vector<int32_t>>()));
+      return helper::oid::INT4_ARRAY;
+    case DataType::BigIntArray:
+      out.append(helper::WriteArray(param.As<std::vector<int64_t>>()));
+      return helper::oid::INT8_ARRAY;
+    case DataType::RealArray:
+      out.append(helper::WriteArray(param.As<std::vector<float>>()));
+      return helper::oid::FLOAT4_ARRAY;
+    case DataType::DoubleArray:
+      out.append(helper::WriteArray(param.As<std::vector<double>>()));
+      return helper::oid::FLOAT8_ARRAY;
+    case DataType::StringArray:
+      out.append(helper::WriteArray(param.As<std::vector<std::string>>()));
+      return helper::oid::TEXT_ARRAY;
+    default:
+      // Strings stay text, their binary form depends on the column type
+      // (e.g. jsonb).
+      AppendTextParam(param, out);
+      return 0;
+  }
+}
+
+/// @brief Encode parameter as postgres binary representation.
+/// @return type OID of the binary value,
+/// 0 when the type has no binary encoding (`value` holds the text).
+inline uint32_t TranslateBinaryParam(const parameters::Param& param,
+                                     std::string& value) {
+  value.clear();
+  return AppendBinaryParam(param, value);
+}
+
+/// @brief Type OID of each parameter in binary format,
+/// 0 for the ones sent as text.
+inline std::vector<uint32_t> BinaryParamTypes(
+    const parameters::ParamView& nvql_params) {
+  std::vector<uint32_t> types;
+  types.reserve(nvql_params.size());
+
+  std::string scratch;
+  for (size_t i = 0; i < nvql_params.size(); i++) {
+    scratch.clear();
+    types.push_back(AppendBinaryParam(nvql_params[i], scratch));
+  }
+  return types;
+}
+
+/// @brief Parameter types statement `id` is prepared with on every
+/// connection, recorded in the catalog by the first caller: `declared` when
+/// given, otherwise the binary types of the parameters, or none in text
+/// format (inferred by the server).
+inline const std::vector<uint32_t>& PreparedParamTypes(
+    PreparedStatementCatalog& catalog, StatementId id,
+    const std::vector<uint32_t>& declared,
+    const parameters::ParamView& nvql_params, bool binary) {
+  auto recorded = catalog.ParamTypes(id);
+  if (recorded) {
+    return *recorded;
+  }
+
+  if (!declared.empty() || !binary) {
+    return catalog.RecordParamTypes(id, declared);
+  }
+  return catalog.RecordParamTypes(id, BinaryParamTypes(nvql_params));
+}
+
+/// @brief Encode parameters in binary format where possible
+/// and request binary results.
+/// @param declared_types parameter types the statement was prepared with,
+/// null to declare them from the parameters. A value is only sent binary
+/// when its type matches the declared one (missing entries are inferred
+/// by the server), otherwise as text.
+inline void TranslateBinaryParams(const parameters::ParamView& nvql_params,
+                                  const std::vector<uint32_t>* declared_types,
+                                  PgAsyncStatement& statement) {
+  bool declare = declared_types == nullptr;
+  statement.values.reserve(nvql_params.size());
+  statement.formats.reserve(nvql_params.size());
+  if (!declare) {
+    statement.param_types = *declared_types;
+  }
+
+  for (size_t i = 0; i < nvql_params.size(); i++) {
+    std::string value;
+    auto type = TranslateBinaryParam(nvql_params[i], value);
+
+    auto declared = declare ? type
+                    : i < declared_types->size() ? (*declared_types)[i]
+                                                 : 0;
+    if (type != 0 && type != declared) {
+      value = TranslateTextParam(nvql_params[i]);
+      type = 0;
+    }
+
+    if (declare) {
+      statement.param_types.push_back(type);
+    }
+    statement.formats.push_back(type != 0 ? 1 : 0);
+    statement.values.emplace_back(std::move(value));
+  }
+
+  statement.binary_result = true;
+}
+
 class PgInnerTransactionBase {
  public:
   virtual ~PgInnerTransactionBase();
 
   virtual ExecutionResultPtr Execute(const __NR_STRING_COMPAT_REF query_key,
-                                     const parameters::ParameterArgs& args);
+                                     const parameters::ParamView& args);
 
   virtual ExecutionResultPtr ExecuteNonPrepared(
       const __NR_STRING_COMPAT_REF query,
-      const parameters::ParameterArgs& args);
+      const parameters::ParamView& args);
 
   virtual void Commit();
   virtual void Rollback();
@@ -108,56 +397,6 @@ class PgInnerTransactionBase {
   PgInnerTransactionType type_;
 };
 
-/**
- * @class PgWorkTransaction
- * @brief PostgreSQL read-write transaction class.
- */
-class PgWorkTransaction final : public PgInnerTransactionBase {
- public:
-  /**
-   * @brief Constructor.
-   * @param conn The PostgreSQL connection.
-   */
-  explicit PgWorkTransaction(pqxx::connection* conn);
-
-  /**
-   * @brief Execute a prepared statement.
-   * @param query_key The query key.
-   * @param args The parameters for the query.
-   * @return The execution result.
-   */
-  ExecutionResultPtr Execute(const __NR_STRING_COMPAT_REF query_key,
-                             const parameters::ParameterArgs& args) override;
-
-  /**
-   * @brief Execute a non-prepared statement.
-   * @param query The query.
-   * @param args The parameters for the query.
-   * @return The execution result.
-   */
-  ExecutionResultPtr ExecuteNonPrepared(
-      const __NR_STRING_COMPAT_REF query,
-      const parameters::ParameterArgs& args) override;
-
-  /**
-   * @brief Commit the transaction.
-   */
-  void Commit() override;
-  /**
-   * @brief Rollback the transaction.
-   */
-  void Rollback() override;
-
- private:
-  pqxx::work txn_;  ///< The PostgreSQL work transaction.
-
-  /**
-   * @brief Create a new work transaction.
-   * @return The created work transaction.
-   */
-  pqxx::work CreateTransaction();
-};
-
 /**
  * @class PgNonTransaction
  * @brief PostgreSQL non-transactional execution class.
@@ -177,7 +416,7 @@ class PgNonTransaction final : public PgInnerTransactionBase {
    * @return The execution result.
    */
   ExecutionResultPtr Execute(const __NR_STRING_COMPAT_REF query_key,
-                             const parameters::ParameterArgs& args) override;
+                             const parameters::ParamView& args) override;
 
   /**
    * @brief Execute a non-prepared statement.
@@ -187,7 +426,7 @@ class PgNonTransaction final : public PgInnerTransactionBase {
    */
   ExecutionResultPtr ExecuteNonPrepared(
       const __NR_STRING_COMPAT_REF query,
-      const parameters::ParameterArgs& args) override;
+      const parameters::ParamView& args) override;
 
   /**
    * @brief Commit the transaction. No operation for non-transaction.
@@ -210,16 +449,26 @@ class PgNonTransaction final : public PgInnerTransactionBase {
 };
 
 /**
- * @class PgReadOnlyTransaction
- * @brief PostgreSQL read-only transaction class.
+ * @class PgDeferredTransaction
+ * @brief PostgreSQL transaction block whose BEGIN was already pipelined
+ * together with the first statement by PgTransaction. Following statements
+ * run inside the open block, COMMIT/ROLLBACK are sent explicitly.
  */
-class PgReadOnlyTransaction final : public PgInnerTransactionBase {
+class PgDeferredTransaction final : public PgInnerTransactionBase {
  public:
   /**
-   * @brief Constructor.
+   * @brief Constructor, the transaction block must be already opened.
    * @param conn The PostgreSQL connection.
+   * @param raw The libpq handle of `conn`.
+   * @param type ReadWrite or ReadOnly.
+   */
+  explicit PgDeferredTransaction(pqxx::connection* conn, PGconn* raw,
+                                 PgInnerTransactionType type);
+
+  /**
+   * @brief Rollback when the block is still open.
    */
-  explicit PgReadOnlyTransaction(pqxx::connection* conn);
+  ~PgDeferredTransaction();
 
   /**
    * @brief Execute a prepared statement.
@@ -228,7 +477,7 @@ class PgReadOnlyTransaction final : public PgInnerTransactionBase {
    * @return The execution result.
    */
   ExecutionResultPtr Execute(const __NR_STRING_COMPAT_REF query_key,
-                             const parameters::ParameterArgs& args) override;
+                             const parameters::ParamView& args) override;
 
   /**
    * @brief Execute a non-prepared statement.
@@ -238,10 +487,11 @@ class PgReadOnlyTransaction final : public PgInnerTransactionBase {
    */
   ExecutionResultPtr ExecuteNonPrepared(
       const __NR_STRING_COMPAT_REF query,
-      const parameters::ParameterArgs& args) override;
+      const parameters::ParamView& args) override;
 
   /**
-   * @brief Commit the transaction.
+   * @brief Commit the transaction, throws when the server rolled it back
+   * because of an earlier failed statement.
    */
   void Commit() override;
 
@@ -250,14 +500,21 @@ class PgReadOnlyTransaction final : public PgInnerTransactionBase {
    */
   void Rollback() override;
 
+  /**
+   * @brief BEGIN command that opens the block for transaction type.
+   */
+  static const char* BeginCommand(PgInnerTransactionType type);
+
  private:
-  pqxx::read_transaction txn_;  ///< The PostgreSQL read-only transaction.
+  PGconn* raw_;
+  bool is_open_;
+  pqxx::nontransaction txn_;  ///< Carrier, sends no BEGIN/COMMIT itself.
 
   /**
-   * @brief Create a new read-only transaction.
-   * @return The created read-only transaction.
+   * @brief Send COMMIT/ROLLBACK.
+   * @return Command tag reported by the server.
    */
-  pqxx::read_transaction CreateTransaction();
+  std::string EndBlock(const char* command);
 };
 
 /**
@@ -283,7 +540,7 @@ class PgSubTransaction final : public PgInnerTransactionBase {
    * @return The execution result.
    */
   ExecutionResultPtr Execute(const __NR_STRING_COMPAT_REF query_key,
-                             const parameters::ParameterArgs& args) override {
+                             const parameters::ParamView& args) override {
     if (args.size() == 0) {
       auto result = txn_.exec_prepared(__NR_CALL_STRING_COMPAT_REF(query_key));
       return std::make_shared<PgExecutionResult>(std::move(result));
@@ -304,7 +561,7 @@ class PgSubTransaction final : public PgInnerTransactionBase {
    */
   ExecutionResultPtr ExecuteNonPrepared(
       const __NR_STRING_COMPAT_REF query,
-      const parameters::ParameterArgs& args) override {
+      const parameters::ParamView& args) override {
     if (args.size() == 0) {
       auto result = txn_.exec(__NR_CALL_STRING_COMPAT_REF(query));
       return std::make_shared<PgExecutionResult>(std::move(result));
@@ -338,34 +595,176 @@ class PgSubTransaction final : public PgInnerTransactionBase {
 }  // namespace impl
 
 
+/// @brief Lease the connection lazily on the first execution,
+/// BEGIN is pipelined with the first statement so a transaction costs
+/// no extra round trip and holds no connection before it is needed.
+/// With TransactionMode::AutoCommit flag the connection is leased
+/// per statement instead, combined with ReadOnly it throws
+/// TransactionException.
 class PgTransaction : public Transaction {
  public:
   explicit PgTransaction(PgServer* server, TransactionMode mode);
 
   virtual ~PgTransaction();
 
-  void Commit() override;
+ protected:
+  void CommitImpl() override;
 
-  void Rollback() override;
+  void RollbackImpl() override;
 
- protected:
   ExecutionResultPtr ExecuteImpl(
       const __NR_STRING_COMPAT_REF query,
-      const parameters::ParameterArgs& args) override;
+      const parameters::ParamView& args) override;
 
   ExecutionResultPtr ExecuteNonPreparedImpl(
       const __NR_STRING_COMPAT_REF query,
-      const parameters::ParameterArgs& args) override;
+      const parameters::ParamView& args) override;
+
+  ExecutionResultPtr ExecuteImpl(
+      const StatementHandle& statement,
+      const parameters::ParamView& args) override;
+
+  /// Executed by PgReactor when the server has reactor enabled,
+  /// otherwise fallback to the TaskPool. The TaskPool is required either
+  /// way, completed statements release the transaction on it.
+  std::future<ExecutionResultPtr> ExecuteAsyncImpl(
+      std::string query, parameters::ParameterArgs args, bool prepared,
+      std::shared_ptr<void> owner) override;
 
  private:
+  // PgServer::Execute runs its ParamView through ExecuteSync
+  friend class PgServer;
+
   PgServer* server_;
   std::shared_ptr<PgConnection> connection_;
   std::unique_ptr<impl::PgInnerTransactionBase> transact_;
+  impl::PgInnerTransactionType inner_type_;
+  // Connection leased, BEGIN not yet sent
+  bool begin_pending_;
+  // Binary parameters & results, libpq direct execution only
+  bool binary_format_;
+  // statement_timeout currently set on the server, LOCAL to the open block
+  // or on the session outside one. Zero for the server default.
+  std::chrono::milliseconds server_timeout_;
+  // Reactor statements of this transaction not yet completed
+  absl::Mutex inflight_mutex_;
+  int inflight_;
+  // Prepared statement bookkeeping of failed reactor statements, applied
+  // by the thread holding the connection (guarded by inflight_mutex_)
+  std::vector<std::function<void()>> async_failures_;
+
+  // Lease the connection on first use
+  void Lease();
+
+  // AutoCommit: return the connection after each statement
+  void ReleaseAutoCommit();
+
+  // Move the leased connection into a lease object,
+  // returned to the pool when the last holder released it
+  std::shared_ptr<void> LeaseUntilReleased();
+
+  // Owner of a reactor statement, keeps the transaction alive and counted
+  // in-flight. Released on the TaskPool, the last reference must not run
+  // ~PgTransaction (blocking ROLLBACK) on the reactor thread.
+  std::shared_ptr<void> AsyncOwner();
+
+  // Block until the reactor statements of this transaction completed,
+  // the connection is back on blocking mode afterwards
+  void WaitAsyncIdle();
+
+  // Reactor error handler running `apply` on the leased connection:
+  // directly when AutoCommit leased it to the statement, otherwise
+  // deferred to ApplyAsyncFailures
+  std::function<void(const std::string&, bool)> AsyncErrorHandler(
+      std::function<void(PgConnection&, const std::string&, bool)> apply);
+
+  void ApplyAsyncFailures();
+
+  // Execute through libpq directly, BEGIN is sent in the same round trip
+  // when pending. The statement evicted by `key` is dropped on the server
+  // ahead of the statement in its own sync segment.
+  ExecutionResultPtr ExecutePipelined(
+      PgAsyncStatement&& statement,
+      const PreparedStatementKey* key = nullptr);
+
+  // Encode into the connection parameter buffer and execute through libpq
+  // in one call, no BEGIN pending and binary format only. Runs the prepared
+  // statement `name`, or `query` unnamed when `name` is null.
+  // `param_types` are the prepared ones, null declares them for `query`.
+  // With both `name` and `query`, a stale plan outside a transaction block
+  // is prepared again from `query` and retried once.
+  ExecutionResultPtr ExecuteDirect(
+      const char* name, const char* query,
+      const std::vector<uint32_t>* param_types,
+      const parameters::ParamView& args,
+      std::optional<StatementId> id = std::nullopt);
+
+  // Libpq direct execution without intermediate parameter copies
+  bool CanExecuteDirect() const;
+
+  // Text or binary parameters, as configured on the server.
+  // `param_types` are the prepared ones, null declares them.
+  void EncodeParams(PgAsyncStatement& statement,
+                    const std::vector<uint32_t>* param_types,
+                    const parameters::ParamView& args) const;
+
+  // BEGIN, followed by SET LOCAL statement_timeout when mirrored
+  std::vector<PgAsyncStatement> BeginStatements() const;
+
+  // Statement timeout the server must enforce, zero when not mirrored
+  std::chrono::milliseconds ServerTimeout() const;
+
+  // SET statement_timeout bringing the server in line with ServerTimeout,
+  // LOCAL inside a block. Empty when already applied.
+  std::string ServerTimeoutCommand() const;
+
+  // Apply ServerTimeoutCommand ahead of a synchronous statement,
+  // a pending BEGIN carries it instead
+  void ApplyServerTimeout();
+
+  // Cancel the statement from pool watchdog when it outlives
+  // the statement timeout
+  template <typename TFunc>
+  ExecutionResultPtr WithDeadline(TFunc&& func);
+
+  ExecutionResultPtr Prepared(const __NR_STRING_COMPAT_REF query,
+                              const parameters::ParamView& args);
+
+  // `param_types` as recorded in the catalog (PreparedParamTypes)
+  ExecutionResultPtr Prepared(const PreparedStatementKey& key,
+                              const std::string& query,
+                              const std::vector<uint32_t>& param_types,
+                              const parameters::ParamView& args);
+
+  // Prepared or non-prepared path, as chosen by the catalog plan selection
+  ExecutionResultPtr Routed(StatementId id, const std::string& query,
+                            const std::vector<uint32_t>& param_types,
+                            const parameters::ParamView& args);
+
+  // PREPARE on the current connection, with typed parameters when given,
+  // forgets `id` when the server rejected it
+  void PrepareOnServer(StatementId id, const std::string& name,
+                       const std::string& query,
+                       const std::vector<uint32_t>& param_types);
+
+  ExecutionResultPtr NonPrepared(const __NR_STRING_COMPAT_REF query,
+                                 const parameters::ParamView& args);
 
   std::shared_ptr<PgConnection> GetConnectionFromPool();
   void ReturnConnectionToThePool();
 
+  static nvm::threads::TaskPoolPtr GetTaskPool(PgServer* server);
+
+  static bool IsBinaryFormat(PgServer* server);
+
+  static PgReactorPtr GetReactor(PgServer* server);
+
+  static QueryWatchdogPtr GetWatchdog(PgServer* server);
+
   std::unique_ptr<impl::PgInnerTransactionBase> CreateTransaction();
+
+  static impl::PgInnerTransactionType ToInnerTransactionType(
+      TransactionMode mode);
 };
 
 NVSERV_END_NAMESPACE
\ No newline at end of file
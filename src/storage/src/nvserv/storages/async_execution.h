@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvm/threads/task_pool.h>
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 202002L
+#include <coroutine>
+#endif
+
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/declare.h"
+#include "nvserv/storages/exceptions.h"
+
+NVSERV_BEGIN_NAMESPACE(storages)
+
+namespace impl {
+
+/// @brief Run `func` on the TaskPool and hand back a future of its result.
+/// Exceptions thrown by `func` are delivered through the future.
+template <typename TFunc>
+std::future<std::invoke_result_t<TFunc>> SubmitToTaskPool(
+    const nvm::threads::TaskPoolPtr& pool, StorageType type, TFunc&& func) {
+  using TResult = std::invoke_result_t<TFunc>;
+
+  if (!pool) {
+    throw UnsupportedFeatureException(
+        "Async execution is disabled, no TaskPool configured "
+        "(TaskPoolMode::None)",
+        type);
+  }
+
+  auto task = std::make_shared<std::packaged_task<TResult()>>(
+      std::forward<TFunc>(func));
+  auto future = task->get_future();
+
+  pool->ExecuteTask([task]() { (*task)(); });
+
+  return future;
+}
+
+}  // namespace impl
+
+#if __cplusplus >= 202002L
+
+/// @brief C++20 awaitable adapter, the work is started on the TaskPool when
+/// the coroutine suspends and the coroutine is resumed on the TaskPool
+/// thread once the work is done.
+template <typename T>
+class Awaitable {
+ public:
+  explicit Awaitable(nvm::threads::TaskPoolPtr pool, StorageType type,
+                     std::function<T()> func)
+                  : pool_(std::move(pool)),
+                    type_(type),
+                    func_(std::move(func)),
+                    result_(),
+                    error_(nullptr) {}
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    impl::SubmitToTaskPool(pool_, type_, [this, handle]() {
+      try {
+        result_.emplace(func_());
+      } catch (...) {
+        error_ = std::current_exception();
+      }
+      handle.resume();
+    });
+  }
+
+  T await_resume() {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return std::move(*result_);
+  }
+
+ private:
+  nvm::threads::TaskPoolPtr pool_;
+  StorageType type_;
+  std::function<T()> func_;
+  std::optional<T> result_;
+  std::exception_ptr error_;
+};
+
+#endif
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "nvserv/global_macro.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/// @brief Read-only view of raw field bytes,
+/// valid as long as the result it comes from is alive.
+class BytesView {
+ public:
+  BytesView()
+                  : data_(nullptr), size_(0) {}
+
+  BytesView(const uint8_t* data, size_t size)
+                  : data_(data), size_(size) {}
+
+  explicit BytesView(std::string_view value)
+                  : data_(reinterpret_cast<const uint8_t*>(value.data())),
+                    size_(value.size()) {}
+
+  const uint8_t* Data() const {
+    return data_;
+  }
+
+  size_t Size() const {
+    return size_;
+  }
+
+  bool Empty() const {
+    return size_ == 0;
+  }
+
+  uint8_t operator[](size_t index) const {
+    return data_[index];
+  }
+
+  const uint8_t* begin() const {
+    return data_;
+  }
+
+  const uint8_t* end() const {
+    return data_ + size_;
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+};
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/column_binding.h"
+
+#include <stdexcept>
+
+#include "nvserv/storages/execution_result.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+ColumnBinding::ColumnBinding(const ExecutionResult& result,
+                             const std::vector<std::string>& column_names,
+                             const std::vector<ColumnReadType>& read_types)
+                : indices_() {
+  indices_.reserve(column_names.size());
+
+  for (size_t i = 0; i < column_names.size(); i++) {
+    auto index = result.ColumnIndex(column_names[i]);
+
+    if (i < read_types.size()) {
+      auto type = result.ColumnType(index);
+      // Types unknown to NvQL are left to the conversion
+      if (type.has_value() && !IsReadable(type.value(), read_types[i])) {
+        throw std::invalid_argument("Column [" + column_names[i] +
+                                    "] type can't be read as the bound type");
+      }
+    }
+
+    indices_.push_back(index);
+  }
+}
+
+size_t ColumnBinding::Size() const {
+  return indices_.size();
+}
+
+const std::vector<int>& ColumnBinding::Indices() const {
+  return indices_;
+}
+
+// static
+bool ColumnBinding::IsReadable(parameters::DataType type,
+                               ColumnReadType read_type) {
+  using parameters::DataType;
+  switch (read_type) {
+    case ColumnReadType::Int16:
+      return type == DataType::SmallInt;
+    case ColumnReadType::Int32:
+      return type == DataType::SmallInt || type == DataType::Int;
+    case ColumnReadType::Int64:
+      return type == DataType::SmallInt || type == DataType::Int ||
+             type == DataType::BigInt;
+    case ColumnReadType::Float:
+      return type == DataType::Real;
+    case ColumnReadType::Double:
+      return type == DataType::Real || type == DataType::Double;
+    case ColumnReadType::DateTime:
+      return type == DataType::Timestamp || type == DataType::Timestampz;
+    case ColumnReadType::String:
+    case ColumnReadType::Unchecked:
+    default:
+      // Every type has text representation
+      return true;
+  }
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nvm/dates/datetime.h"
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/declare.h"
+#include "nvserv/storages/parameters/param.h"
+#include "nvserv/storages/row_result.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/// @brief C++ type a bound column is read as, for the type check.
+enum class ColumnReadType {
+  Unchecked,
+  Int16,
+  Int32,
+  Int64,
+  Float,
+  Double,
+  String,
+  DateTime
+};
+
+template <typename T>
+constexpr ColumnReadType ColumnReadTypeOf() {
+  if constexpr (is_type_v<T, int16_t>) {
+    return ColumnReadType::Int16;
+  } else if constexpr (is_type_v<T, int32_t>) {
+    return ColumnReadType::Int32;
+  } else if constexpr (is_type_v<T, int64_t>) {
+    return ColumnReadType::Int64;
+  } else if constexpr (is_type_v<T, float>) {
+    return ColumnReadType::Float;
+  } else if constexpr (is_type_v<T, double>) {
+    return ColumnReadType::Double;
+  } else if constexpr (is_type_v<T, std::string>) {
+    return ColumnReadType::String;
+  } else if constexpr (is_type_v<T, nvm::dates::DateTime>) {
+    return ColumnReadType::DateTime;
+  } else {
+    return ColumnReadType::Unchecked;
+  }
+}
+
+/// @brief Column names resolved to indices once per result,
+/// reused for every row so name-based access costs the same as index.
+///
+/// @code
+/// auto binding = ColumnBinding::Of<int32_t, std::string, int16_t>(
+///     *result, {"user_id", "username", "status"});
+/// for (const auto row : result->Rows()) {
+///   auto dyn = Mapper::Dynamic<int32_t, std::string, int16_t>(row, binding);
+/// }
+/// @endcode
+class ColumnBinding {
+ public:
+  /// @brief Resolve the columns, throws std::invalid_argument when a column
+  /// is not exist or its type can't be read as the given read type.
+  /// @param read_types expected read type per column, empty skips the check
+  ColumnBinding(const ExecutionResult& result,
+                const std::vector<std::string>& column_names,
+                const std::vector<ColumnReadType>& read_types = {});
+
+  /// @brief Resolve the columns with the type check of Args.
+  template <typename... Args>
+  static ColumnBinding Of(const ExecutionResult& result,
+                          const std::vector<std::string>& column_names);
+
+  /// @brief Column index of the bound position.
+  int operator[](size_t position) const {
+    return indices_[position];
+  }
+
+  size_t Size() const;
+
+  const std::vector<int>& Indices() const;
+
+  /// @brief Column of database type can be read as the read type.
+  static bool IsReadable(parameters::DataType type, ColumnReadType read_type);
+
+ private:
+  std::vector<int> indices_;
+};
+
+template <typename... Args>
+ColumnBinding ColumnBinding::Of(const ExecutionResult& result,
+                                const std::vector<std::string>& column_names) {
+  if (column_names.size() != sizeof...(Args)) {
+    throw std::invalid_argument(
+        "ColumnBinding::Of, column names and types count mismatch");
+  }
+  return ColumnBinding(result, column_names, {ColumnReadTypeOf<Args>()...});
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/column_set.h"
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "nvserv/exceptions.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+ColumnKind ColumnKindOf(parameters::DataType type) {
+  using parameters::DataType;
+  switch (type) {
+    case DataType::SmallInt:
+    case DataType::Int:
+    case DataType::BigInt:
+      return ColumnKind::Int64;
+    case DataType::Real:
+    case DataType::Double:
+      return ColumnKind::Double;
+    case DataType::Timestamp:
+    case DataType::Timestampz:
+      return ColumnKind::Timestamp;
+    default:
+      return ColumnKind::String;
+  }
+}
+
+/* ColumnVector */
+
+ColumnVector::ColumnVector(std::string name, ColumnKind kind)
+                : name_(std::move(name)),
+                  kind_(kind),
+                  size_(0),
+                  null_count_(0),
+                  validity_(),
+                  int64s_(),
+                  doubles_(),
+                  offsets_(),
+                  data_() {
+  if (kind_ == ColumnKind::String) {
+    offsets_.push_back(0);
+  }
+}
+
+const std::string& ColumnVector::Name() const {
+  return name_;
+}
+
+ColumnKind ColumnVector::Kind() const {
+  return kind_;
+}
+
+size_t ColumnVector::Size() const {
+  return size_;
+}
+
+size_t ColumnVector::NullCount() const {
+  return null_count_;
+}
+
+bool ColumnVector::IsValid(size_t row) const {
+  if (row >= size_) {
+    throw nvserv::OutOfBoundException("`IsValid` row out of range [" +
+                                      std::to_string(row) + "]");
+  }
+  return (validity_[row >> 3] >> (row & 7)) & 1;
+}
+
+const std::vector<uint8_t>& ColumnVector::Validity() const {
+  return validity_;
+}
+
+const std::vector<int64_t>& ColumnVector::Int64s() const {
+  return int64s_;
+}
+
+const std::vector<double>& ColumnVector::Doubles() const {
+  return doubles_;
+}
+
+const std::vector<uint32_t>& ColumnVector::Offsets() const {
+  return offsets_;
+}
+
+const std::string& ColumnVector::Data() const {
+  return data_;
+}
+
+std::string_view ColumnVector::StringAt(size_t row) const {
+  if (kind_ != ColumnKind::String || row >= size_) {
+    throw nvserv::OutOfBoundException("`StringAt` row out of range [" +
+                                      std::to_string(row) + "]");
+  }
+  return std::string_view(data_).substr(offsets_[row],
+                                        offsets_[row + 1] - offsets_[row]);
+}
+
+void ColumnVector::Reserve(size_t rows, size_t data_bytes) {
+  validity_.reserve((rows + 7) / 8);
+  switch (kind_) {
+    case ColumnKind::Int64:
+    case ColumnKind::Timestamp:
+      int64s_.reserve(rows);
+      break;
+    case ColumnKind::Double:
+      doubles_.reserve(rows);
+      break;
+    case ColumnKind::String:
+      offsets_.reserve(rows + 1);
+      data_.reserve(data_bytes);
+      break;
+  }
+}
+
+void ColumnVector::AppendNull() {
+  AppendValidity(false);
+  null_count_++;
+  switch (kind_) {
+    case ColumnKind::Int64:
+    case ColumnKind::Timestamp:
+      int64s_.push_back(0);
+      break;
+    case ColumnKind::Double:
+      doubles_.push_back(0.0);
+      break;
+    case ColumnKind::String:
+      offsets_.push_back(static_cast<uint32_t>(data_.size()));
+      break;
+  }
+}
+
+void ColumnVector::AppendInt64(int64_t value) {
+  AppendValidity(true);
+  int64s_.push_back(value);
+}
+
+void ColumnVector::AppendDouble(double value) {
+  AppendValidity(true);
+  doubles_.push_back(value);
+}
+
+void ColumnVector::AppendString(std::string_view value) {
+  if (data_.size() + value.size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("Column [" + name_ +
+                            "] string data exceeds 4GiB");
+  }
+  AppendValidity(true);
+  data_.append(value.data(), value.size());
+  offsets_.push_back(static_cast<uint32_t>(data_.size()));
+}
+
+void ColumnVector::Append(const ColumnVector& chunk) {
+  if (chunk.kind_ != kind_) {
+    throw std::invalid_argument("Column [" + name_ +
+                                "] can't append chunk of another kind");
+  }
+
+  if ((size_ & 7) == 0) {
+    validity_.insert(validity_.end(), chunk.validity_.begin(),
+                     chunk.validity_.end());
+    size_ += chunk.size_;
+  } else {
+    for (size_t row = 0; row < chunk.size_; row++) {
+      AppendValidity((chunk.validity_[row >> 3] >> (row & 7)) & 1);
+    }
+  }
+  null_count_ += chunk.null_count_;
+
+  switch (kind_) {
+    case ColumnKind::Int64:
+    case ColumnKind::Timestamp:
+      int64s_.insert(int64s_.end(), chunk.int64s_.begin(),
+                     chunk.int64s_.end());
+      break;
+    case ColumnKind::Double:
+      doubles_.insert(doubles_.end(), chunk.doubles_.begin(),
+                      chunk.doubles_.end());
+      break;
+    case ColumnKind::String: {
+      if (data_.size() + chunk.data_.size() >
+          std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Column [" + name_ +
+                                "] string data exceeds 4GiB");
+      }
+      auto base = static_cast<uint32_t>(data_.size());
+      offsets_.reserve(offsets_.size() + chunk.size_);
+      for (size_t row = 1; row < chunk.offsets_.size(); row++) {
+        offsets_.push_back(base + chunk.offsets_[row]);
+      }
+      data_.append(chunk.data_);
+      break;
+    }
+  }
+}
+
+// private:
+
+void ColumnVector::AppendValidity(bool valid) {
+  if ((size_ & 7) == 0) {
+    validity_.push_back(0);
+  }
+  if (valid) {
+    validity_.back() |= static_cast<uint8_t>(1u << (size_ & 7));
+  }
+  size_++;
+}
+
+/* ColumnSet */
+
+ColumnSet::ColumnSet() : columns_() {}
+
+size_t ColumnSet::RowCount() const {
+  return columns_.empty() ? 0 : columns_.front().Size();
+}
+
+size_t ColumnSet::ColumnCount() const {
+  return columns_.size();
+}
+
+const ColumnVector& ColumnSet::At(size_t index) const {
+  if (index >= columns_.size()) {
+    throw nvserv::OutOfBoundException("`At` column index out of range [" +
+                                      std::to_string(index) + "]");
+  }
+  return columns_[index];
+}
+
+const ColumnVector& ColumnSet::At(const std::string& column_name) const {
+  for (const auto& column : columns_) {
+    if (column.Name() == column_name) {
+      return column;
+    }
+  }
+  throw std::invalid_argument("Unknown column [" + column_name + "]");
+}
+
+const std::vector<ColumnVector>& ColumnSet::Columns() const {
+  return columns_;
+}
+
+void ColumnSet::Add(ColumnVector&& column) {
+  columns_.emplace_back(std::move(column));
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/parameters/param.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/// @brief Physical layout of a materialized column.
+enum class ColumnKind {
+  Int64,      // int2, int4, int8
+  Double,     // real, double precision
+  Timestamp,  // timestamp(tz) as unix microseconds UTC, stored in Int64s()
+  String      // every other type as text, offsets + data
+};
+
+/// @brief Column kind a database type is materialized as.
+ColumnKind ColumnKindOf(parameters::DataType type);
+
+/// @brief Contiguous typed array of one result column with validity bitmap,
+/// Arrow-like layout: bit i of Validity() is set when row i is not null,
+/// null slots hold zero (or an empty string).
+class ColumnVector {
+ public:
+  ColumnVector(std::string name, ColumnKind kind);
+
+  const std::string& Name() const;
+
+  ColumnKind Kind() const;
+
+  size_t Size() const;
+
+  size_t NullCount() const;
+
+  bool IsValid(size_t row) const;
+
+  const std::vector<uint8_t>& Validity() const;
+
+  /// @brief Values of Int64 & Timestamp column.
+  const std::vector<int64_t>& Int64s() const;
+
+  const std::vector<double>& Doubles() const;
+
+  /// @brief String row i is Data()[Offsets()[i], Offsets()[i + 1]).
+  const std::vector<uint32_t>& Offsets() const;
+
+  const std::string& Data() const;
+
+  std::string_view StringAt(size_t row) const;
+
+  /// @brief Size the arrays once before appending,
+  /// data_bytes is the total string bytes when known.
+  void Reserve(size_t rows, size_t data_bytes = 0);
+
+  void AppendNull();
+
+  void AppendInt64(int64_t value);
+
+  void AppendDouble(double value);
+
+  void AppendString(std::string_view value);
+
+  /// @brief Append the rows of a chunk decoded separately, same kind.
+  /// Validity bytes are copied as they are when Size() is a multiple of 8.
+  void Append(const ColumnVector& chunk);
+
+ private:
+  std::string name_;
+  ColumnKind kind_;
+  size_t size_;
+  size_t null_count_;
+  std::vector<uint8_t> validity_;
+  std::vector<int64_t> int64s_;
+  std::vector<double> doubles_;
+  std::vector<uint32_t> offsets_;
+  std::string data_;
+
+  void AppendValidity(bool valid);
+};
+
+/// @brief Result materialized column by column,
+/// see ExecutionResult::ToColumns.
+class ColumnSet {
+ public:
+  ColumnSet();
+
+  size_t RowCount() const;
+
+  size_t ColumnCount() const;
+
+  const ColumnVector& At(size_t index) const;
+
+  /// @brief Column by name, throws std::invalid_argument when unknown.
+  const ColumnVector& At(const std::string& column_name) const;
+
+  const std::vector<ColumnVector>& Columns() const;
+
+  void Add(ColumnVector&& column);
+
+ private:
+  std::vector<ColumnVector> columns_;
+};
+
+NVSERV_END_NAMESPACE
@@ -81,6 +81,12 @@ PreparedStatementManagerPtr Connection::PreparedStatement() {
   return prepared_statement_manager_;
 }
 
+void Connection::AttachStatementCatalog(
+    const PreparedStatementCatalogPtr& catalog, uint32_t capacity) {
+  prepared_statement_manager_ =
+      std::make_shared<PreparedStatementManager>(catalog, capacity);
+}
+
 bool Connection::IsIdle() const {
   auto idle = IdleDuration();
   return idle > mark_idle_after_ ? true : false;
@@ -86,7 +86,7 @@ class ConnectionBase {
 
   virtual const std::string& GetConnectionString() const = 0;
 
-  virtual std::optional<std::pair<std::string, bool>> PrepareStatement(
+  virtual std::optional<PreparedStatementKey> PrepareStatement(
       __NR_STRING_COMPAT_REF query) = 0;
   virtual PreparedStatementManagerPtr PreparedStatement() = 0;
 
@@ -117,6 +117,12 @@ class Connection : public ConnectionBase {
 
   PreparedStatementManagerPtr PreparedStatement() override;
 
+  /// @brief Share the pool-wide statement catalog,
+  /// must be attached before the connection is opened.
+  /// @param capacity max prepared statements kept, 0 is unbounded
+  void AttachStatementCatalog(const PreparedStatementCatalogPtr& catalog,
+                              uint32_t capacity = 0);
+
   bool IsIdle() const override;
 
   /// Duration since last usage
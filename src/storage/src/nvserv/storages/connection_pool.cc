@@ -28,8 +28,17 @@ ConnectionPool::ConnectionPool(const std::string& name,
                                const StorageConfig& config)
                 : name_(std::string(name)),
                   config_(config),
+                  create_primary_connection_callback_(nullptr),
+                  create_secondary_connection_callback_(nullptr),
+                  is_run_(false),
+                  is_ready_(false),
                   task_ping_ptr_(nullptr),
-                  task_clean_ptr_(nullptr) {};
+                  task_clean_ptr_(nullptr),
+                  task_watchdog_ptr_(nullptr),
+                  watchdog_(std::make_shared<QueryWatchdog>()),
+                  statement_catalog_(
+                      std::make_shared<PreparedStatementCatalog>(
+                          config.PoolConfig().AdaptivePlanSelection())) {};
 
 ConnectionPool::~ConnectionPool() {}
 
@@ -163,6 +172,14 @@ const bool& ConnectionPool::IsRun() const {
   return is_run_;
 }
 
+const QueryWatchdogPtr& ConnectionPool::Watchdog() const {
+  return watchdog_;
+}
+
+const PreparedStatementCatalogPtr& ConnectionPool::StatementCatalog() const {
+  return statement_catalog_;
+}
+
 void ConnectionPool::InitializePrimaryConnections() {
   auto min_conn = config_.PoolConfig().MinConnection() == 0
                       ? DEFAULT_WORKER_MINIMAL
@@ -170,6 +187,8 @@ void ConnectionPool::InitializePrimaryConnections() {
 
   for (size_t i = 0; i < min_conn; i++) {
     auto conn = create_primary_connection_callback_(name_, &config_);
+    conn->AttachStatementCatalog(
+        statement_catalog_, config_.PoolConfig().PreparedStatementCapacity());
     auto key = conn->GetHash();
 
     // get pointer to the node
@@ -210,6 +229,14 @@ void ConnectionPool::InitializeServices() {
   services_.SubmitTask(task_clean_ptr_ ,
                        threads::EventLoopExecutor::TaskType::RunAtInterval,
                        cleanup_interval, cleanup_interval);
+
+  auto watchdog_interval =
+      absl::FromChrono(std::chrono::milliseconds(DEFAULT_WATCHDOG_INTERVAL));
+  task_watchdog_ptr_ = threads::MakeTaskPtr([this]() { watchdog_->Check(); });
+
+  services_.SubmitTask(task_watchdog_ptr_,
+                       threads::EventLoopExecutor::TaskType::RunAtInterval,
+                       watchdog_interval, watchdog_interval);
 }
 
 void ConnectionPool::RunImpl() {
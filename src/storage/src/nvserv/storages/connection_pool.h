@@ -33,6 +33,8 @@
 #include "nvserv/headers/absl_thread.h"
 #include "nvserv/storages/connection.h"
 #include "nvserv/storages/declare.h"
+#include "nvserv/storages/prepared_statement_catalog.h"
+#include "nvserv/storages/query_watchdog.h"
 #include "nvserv/storages/storage_config.h"
 #include "nvserv/threads/event_loop_executor.h"
 // cppcheck-suppress unknownMacro
@@ -51,6 +53,9 @@ class ConnectionPool {
       std::chrono::seconds(30);
   static constexpr std::chrono::seconds DEFAULT_MAX_WAITING_FOR_CONNECTION =
       std::chrono::seconds(5);
+  // Resolution of statement deadline enforcement
+  static constexpr std::chrono::milliseconds DEFAULT_WATCHDOG_INTERVAL =
+      std::chrono::milliseconds(10);
 
   static constexpr uint16_t DEFAULT_WORKER_MINIMAL = 1;
   static constexpr uint16_t DEFAULT_WORKER_MAXIMAL = 1;
@@ -82,6 +87,12 @@ class ConnectionPool {
 
   const bool& IsRun() const;
 
+  /// @brief Statement deadlines enforced by the pool services thread.
+  const QueryWatchdogPtr& Watchdog() const;
+
+  /// @brief Statements interned once for all connections of the pool.
+  const PreparedStatementCatalogPtr& StatementCatalog() const;
+
  protected:
   std::string name_;
   const StorageConfig& config_;
@@ -114,6 +125,9 @@ class ConnectionPool {
   threads::EventLoopExecutor services_;
   threads::EventLoopExecutor::TaskPtr task_ping_ptr_;
   threads::EventLoopExecutor::TaskPtr task_clean_ptr_;
+  threads::EventLoopExecutor::TaskPtr task_watchdog_ptr_;
+  QueryWatchdogPtr watchdog_;
+  PreparedStatementCatalogPtr statement_catalog_;
 
   void InitializePrimaryConnections();
 
@@ -31,7 +31,8 @@ ConnectionPoolConfig::ConnectionPoolConfig(
     std::chrono::seconds connection_idle_wait,
     std::chrono::seconds max_waiting_for_connection,
     std::chrono::seconds max_waiting_for_trans_creation,
-    std::chrono::seconds cleanup_interval)
+    std::chrono::seconds cleanup_interval,
+    uint32_t prepared_statement_capacity, bool adaptive_plan_selection)
                 : min_connection_(min_connection),
                   max_connection_(max_connection),
                   keep_alive_(keep_alive),
@@ -41,14 +42,16 @@ ConnectionPoolConfig::ConnectionPoolConfig(
                   max_waiting_for_connection_(max_waiting_for_connection),
                   max_waiting_for_trans_creation_(
                       max_waiting_for_trans_creation),
-                  cleanup_interval_(cleanup_interval) {}
+                  cleanup_interval_(cleanup_interval),
+                  prepared_statement_capacity_(prepared_statement_capacity),
+                  adaptive_plan_selection_(adaptive_plan_selection) {}
 
 const uint16_t& ConnectionPoolConfig::MinConnection() const {
   return min_connection_;
 }
 
 const uint16_t& ConnectionPoolConfig::MaxConnection() const {
-  return min_connection_;
+  return max_connection_;
 }
 
 const bool& ConnectionPoolConfig::KeepAlive() const {
@@ -81,4 +84,12 @@ const std::chrono::seconds& ConnectionPoolConfig::CleanupInterval() const {
   return cleanup_interval_;
 }
 
+const uint32_t& ConnectionPoolConfig::PreparedStatementCapacity() const {
+  return prepared_statement_capacity_;
+}
+
+const bool& ConnectionPoolConfig::AdaptivePlanSelection() const {
+  return adaptive_plan_selection_;
+}
+
 NVSERV_END_NAMESPACE
\ No newline at end of file
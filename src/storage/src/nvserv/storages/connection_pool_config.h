@@ -42,7 +42,9 @@ class ConnectionPoolConfig {
       std::chrono::seconds max_waiting_for_connection = std::chrono::seconds(5),
       std::chrono::seconds max_waiting_for_trans_creation =
           std::chrono::seconds(5),
-      std::chrono::seconds cleanup_interval = std::chrono::seconds(45));
+      std::chrono::seconds cleanup_interval = std::chrono::seconds(45),
+      uint32_t prepared_statement_capacity = 256,
+      bool adaptive_plan_selection = false);
 
   const uint16_t& MinConnection() const;
 
@@ -62,6 +64,17 @@ class ConnectionPoolConfig {
 
   const std::chrono::seconds& CleanupInterval() const ;
 
+  /// Max prepared statements kept per connection,
+  /// least recently used are deallocated. 0 is unbounded.
+  /// Bounds the server side only, the pool-wide catalog keeps every
+  /// distinct SQL ever executed as prepared (see PreparedStatementCatalog),
+  /// run dynamically built SQL with ExecuteNonPrepared.
+  const uint32_t& PreparedStatementCapacity() const;
+
+  /// Route each statement through the prepared (generic plan) or
+  /// non-prepared (custom plan) path, whichever is measurably faster.
+  const bool& AdaptivePlanSelection() const;
+
  protected:
   uint16_t min_connection_;
   uint16_t max_connection_;
@@ -72,6 +85,8 @@ class ConnectionPoolConfig {
   std::chrono::seconds max_waiting_for_connection_;
   std::chrono::seconds max_waiting_for_trans_creation_;
   std::chrono::seconds cleanup_interval_;
+  uint32_t prepared_statement_capacity_;
+  bool adaptive_plan_selection_;
 };
 
 NVSERV_END_NAMESPACE
\ No newline at end of file
@@ -28,6 +28,14 @@
 
 #include "nvserv/global_macro.h"
 
+// Postgres is the only storage driver compiled in, results are always
+// postgres results and typed row access can skip virtual dispatch.
+#if defined(NVQL_FEATURE_POSTGRES) && NVQL_FEATURE_POSTGRES == 1
+#define NVQL_SINGLE_DRIVER 1
+#else
+#define NVQL_SINGLE_DRIVER 0
+#endif
+
 NVSERV_BEGIN_NAMESPACE(storages)
 
 class StorageServer;
@@ -36,6 +44,7 @@ class ClusterConfig;
 class ExecutionResult;
 class RowResult;
 class PreparedStatementManager;
+class PreparedStatementCatalog;
 class StorageConfig;
 class Connection;
 class ConnectionPool;
@@ -51,6 +60,7 @@ using ClusterConfigListType = std::vector<std::shared_ptr<ClusterConfig>>;
 using ExecutionResultPtr = std::shared_ptr<ExecutionResult>;
 using RowResultPtr = std::shared_ptr<RowResult>;
 using PreparedStatementManagerPtr = std::shared_ptr<PreparedStatementManager>;
+using PreparedStatementCatalogPtr = std::shared_ptr<PreparedStatementCatalog>;
 using ConnectionPtr = std::shared_ptr<Connection>;
 
 /// @brief NvServ storage driver
@@ -112,7 +122,13 @@ enum class TransactionMode : uint16_t {
   //
   // Support: pg.
   // Fallback: ReadWrite on others
-  NonTransaction = 8
+  NonTransaction = 8,
+  // Flag, each statement runs alone in implicit transaction (no BEGIN/COMMIT)
+  // and the connection is returned to the pool right after it completed.
+  // Can't be combined with ReadOnly, rejected with TransactionException.
+  //
+  // Support: pg.
+  AutoCommit = 16
 };
 
 // NOLINTNEXTLINE
@@ -129,7 +145,9 @@ NVM_ENUM_TO_STRING_FORMATTER(TransactionMode, case TransactionMode::Unknown
                              case TransactionMode::ReadOnly
                              : return "ReadOnly";
                              case TransactionMode::NonTransaction
-                             : return "NonTransaction";)
+                             : return "NonTransaction";
+                             case TransactionMode::AutoCommit
+                             : return "AutoCommit";)
 
 enum class ConnectionMode {
   Unknown = 0,
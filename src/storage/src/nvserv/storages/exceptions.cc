@@ -43,6 +43,10 @@ ExecutionException::ExecutionException(const std::string& message,
                                        const StorageType& type)
                 : TransactionException(message, type) {}
 
+QueryTimeoutException::QueryTimeoutException(const std::string& message,
+                                             const StorageType& type)
+                : ExecutionException(message, type) {}
+
 InternalErrorException::InternalErrorException(const std::string& message,
                                                const StorageType& type)
                 : StorageException(message, type) {}
@@ -56,6 +56,13 @@ class ExecutionException : public TransactionException {
                               const StorageType& type);
 };
 
+/// @brief Statement cancelled because it exceeded its deadline.
+class QueryTimeoutException : public ExecutionException {
+ public:
+  explicit QueryTimeoutException(const std::string& message,
+                                 const StorageType& type);
+};
+
 class InternalErrorException : public StorageException {
  public:
   explicit InternalErrorException(const std::string& message,
@@ -68,7 +75,7 @@ class ParameterTypeException : public StorageException {
                                   const StorageType& type);
 };
 
-class UnsupportedFeatureException : StorageException {
+class UnsupportedFeatureException : public StorageException {
  public:
   explicit UnsupportedFeatureException(const std::string& message,
                                        const StorageType& type);
@@ -21,6 +21,10 @@
 
 #include "nvserv/storages/execution_result.h"
 
+#include <algorithm>
+
+#include "nvserv/exceptions.h"
+
 // cppcheck-suppress unknownMacro
 NVSERV_BEGIN_NAMESPACE(storages)
 
@@ -31,6 +35,112 @@ StorageType ExecutionResult::Type() const {
   return type_;
 }
 
+RowView ExecutionResult::Row(const int& offset) const {
+  if (offset < 0 || offset >= RowCount()) {
+    throw nvserv::OutOfBoundException("`Row` offset out of range [" +
+                                      std::to_string(offset) + "]");
+  }
+  return RowView(*this, offset);
+}
+
+RowViewRange ExecutionResult::Rows() const {
+  return RowViewRange(*this);
+}
+
+ColumnSet ExecutionResult::ToColumns() const {
+  return ToColumns(nvm::threads::TaskPoolPtr());
+}
+
+ColumnSet ExecutionResult::ToColumns(
+    const std::vector<std::string>& column_names) const {
+  return ToColumns(column_names, nullptr);
+}
+
+ColumnSet ExecutionResult::ToColumns(const nvm::threads::TaskPoolPtr& pool,
+                                     size_t min_chunk_rows) const {
+  std::vector<int> indices;
+  auto columns = ColumnCount();
+  indices.reserve(static_cast<size_t>(columns));
+  for (int i = 0; i < columns; i++) {
+    indices.push_back(i);
+  }
+  return MaterializeColumns(indices, pool, min_chunk_rows);
+}
+
+ColumnSet ExecutionResult::ToColumns(
+    const std::vector<std::string>& column_names,
+    const nvm::threads::TaskPoolPtr& pool, size_t min_chunk_rows) const {
+  std::vector<int> indices;
+  indices.reserve(column_names.size());
+  for (const auto& name : column_names) {
+    indices.push_back(ColumnIndex(name));
+  }
+  return MaterializeColumns(indices, pool, min_chunk_rows);
+}
+
+// private:
+
+ColumnSet ExecutionResult::MaterializeColumns(
+    const std::vector<int>& indices, const nvm::threads::TaskPoolPtr& pool,
+    size_t min_chunk_rows) const {
+  std::vector<ColumnVector> columns;
+  columns.reserve(indices.size());
+  for (auto index : indices) {
+    auto type = ColumnType(index);
+    auto kind = type.has_value() ? ColumnKindOf(type.value())
+                                 : ColumnKind::String;
+    columns.emplace_back(ColumnName(index), kind);
+  }
+
+  auto rows = static_cast<size_t>(RowCount());
+  auto chunks = pool ? ParallelChunkCount(rows, min_chunk_rows) : 1;
+  // Multiple of 8 rows, validity bytes of the chunks concatenate as they are
+  auto chunk_rows = ((rows + chunks - 1) / chunks + 7) & ~size_t{7};
+  if (chunk_rows > 0) {
+    chunks = (rows + chunk_rows - 1) / chunk_rows;
+  }
+
+  // The first chunk decodes straight into the column,
+  // the others into their own part appended afterwards
+  std::vector<ColumnVector> parts;
+  parts.reserve(columns.size() * (chunks - 1));
+  for (const auto& column : columns) {
+    for (size_t chunk = 1; chunk < chunks; chunk++) {
+      parts.emplace_back(column.Name(), column.Kind());
+    }
+  }
+
+  ParallelChunks(pool, columns.size() * chunks, [&](size_t task) {
+    auto i = task / chunks;
+    auto chunk = task % chunks;
+    auto begin = static_cast<int>(chunk * chunk_rows);
+    auto end = static_cast<int>(std::min(rows, (chunk + 1) * chunk_rows));
+    auto& out =
+        chunk == 0 ? columns[i] : parts[i * (chunks - 1) + chunk - 1];
+    DecodeColumn(indices[i], begin, end, out);
+  });
+
+  if (chunks > 1) {
+    ParallelChunks(pool, columns.size(), [&](size_t i) {
+      auto first = parts.begin() + i * (chunks - 1);
+      auto data_bytes = columns[i].Data().size();
+      for (auto part = first; part != first + (chunks - 1); ++part) {
+        data_bytes += part->Data().size();
+      }
+      columns[i].Reserve(rows, data_bytes);
+      for (auto part = first; part != first + (chunks - 1); ++part) {
+        columns[i].Append(*part);
+      }
+    });
+  }
+
+  ColumnSet set;
+  for (auto& column : columns) {
+    set.Add(std::move(column));
+  }
+  return set;
+}
+
 Cursor::Cursor(const ExecutionResult& exec_result)
                 : exec_result_(exec_result) {}
 
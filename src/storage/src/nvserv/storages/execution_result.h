@@ -21,15 +21,30 @@
 
 #pragma once
 
+#include <nvm/threads/task_pool.h>
+
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "nvserv/global_macro.h"
+#include "nvserv/storages/bytes_view.h"
+#include "nvserv/storages/column_binding.h"
+#include "nvserv/storages/column_set.h"
 #include "nvserv/storages/declare.h"
 #include "nvserv/storages/mapper.h"
+#include "nvserv/storages/model_mapping.h"
+#include "nvserv/storages/parallel_decode.h"
+#include "nvserv/storages/parameters/param.h"
 #include "nvserv/storages/row_result.h"
 #include "nvserv/storages/row_result_iterator.h"
+#include "nvserv/storages/row_view.h"
 
 NVSERV_BEGIN_NAMESPACE(storages)
 
@@ -43,11 +58,121 @@ class ExecutionResult {
   virtual std::unique_ptr<RowResultIterator> end() const = 0;
   StorageType Type() const;
 
+  virtual int RowCount() const = 0;
+
+  /// @brief Row view at offset, no allocation.
+  RowView Row(const int& offset) const;
+
+  /// @brief Allocation-free iteration, prefer over Cursor on large results.
+  RowViewRange Rows() const;
+
+  /// @brief Decode every row into TModel declared by NVQL_MAP.
+  /// Columns are resolved & type checked once, values are moved straight
+  /// into the members without intermediate tuple.
+  template <typename TModel>
+  std::vector<TModel> ToVector() const;
+
+  /// @brief ToVector with the row range split in chunks decoded in parallel
+  /// on the TaskPool (e.g. StorageServer::TaskPool()), sequential when the
+  /// pool is null or the result is smaller than two chunks.
+  template <typename TModel>
+  std::vector<TModel> ToVector(
+      const nvm::threads::TaskPoolPtr& pool,
+      size_t min_chunk_rows = DEFAULT_PARALLEL_CHUNK_ROWS) const;
+
+  /// @brief Materialize every column as contiguous typed array,
+  /// decoded column by column, see ColumnKind for the type mapping.
+  ColumnSet ToColumns() const;
+
+  /// @brief Materialize the selected columns only.
+  ColumnSet ToColumns(const std::vector<std::string>& column_names) const;
+
+  /// @brief ToColumns with every column split in row chunks as ToVector
+  /// does, the chunks of all columns are decoded in parallel on the
+  /// TaskPool and concatenated. Sequential when the pool is null.
+  ColumnSet ToColumns(
+      const nvm::threads::TaskPoolPtr& pool,
+      size_t min_chunk_rows = DEFAULT_PARALLEL_CHUNK_ROWS) const;
+
+  ColumnSet ToColumns(
+      const std::vector<std::string>& column_names,
+      const nvm::threads::TaskPoolPtr& pool,
+      size_t min_chunk_rows = DEFAULT_PARALLEL_CHUNK_ROWS) const;
+
+  virtual int ColumnCount() const = 0;
+
+  /// @brief Column index by name, throws std::invalid_argument when unknown.
+  virtual int ColumnIndex(const std::string& column_name) const = 0;
+
+  virtual std::string ColumnName(const int& index) const = 0;
+
+  /// @brief Column type, nullopt when the type is not known by NvQL.
+  virtual std::optional<parameters::DataType> ColumnType(
+      const int& index) const = 0;
+
  protected:
+  friend class RowView;
+
   explicit ExecutionResult(StorageType type);
 
+  virtual int16_t AsImpl_int16_t(const int& row, const int& index) const = 0;
+  virtual int32_t AsImpl_int32_t(const int& row, const int& index) const = 0;
+  virtual int64_t AsImpl_int64_t(const int& row, const int& index) const = 0;
+  virtual std::string AsImpl_string(const int& row,
+                                    const int& index) const = 0;
+  virtual float AsImpl_float(const int& row, const int& index) const = 0;
+  virtual double AsImpl_double(const int& row, const int& index) const = 0;
+  virtual nvm::dates::DateTime AsImpl_DateTime_Timestampz(
+      const int& row, const int& index) const = 0;
+  virtual nvm::dates::DateTime AsImpl_DateTime_Timestamp(
+      const int& row, const int& index) const = 0;
+
+  virtual std::string_view AsImpl_string_view(const int& row,
+                                              const int& index) const = 0;
+  virtual BytesView AsImpl_bytes(const int& row, const int& index) const = 0;
+
+  virtual std::vector<int16_t> AsImpl_vector_int16_t(
+      const int& row, const int& index) const = 0;
+  virtual std::vector<int32_t> AsImpl_vector_int32_t(
+      const int& row, const int& index) const = 0;
+  virtual std::vector<int64_t> AsImpl_vector_int64_t(
+      const int& row, const int& index) const = 0;
+  virtual std::vector<float> AsImpl_vector_float(
+      const int& row, const int& index) const = 0;
+  virtual std::vector<double> AsImpl_vector_double(
+      const int& row, const int& index) const = 0;
+  virtual std::vector<std::string> AsImpl_vector_string(
+      const int& row, const int& index) const = 0;
+
+  /// @brief Append rows [begin, end) of the column.
+  virtual void DecodeColumn(const int& index, const int& begin,
+                            const int& end, ColumnVector& column) const = 0;
+
+  /// @brief Field is null, throws std::invalid_argument on unknown column.
+  virtual bool IsNull(const int& row, const int& index) const = 0;
+
+  /// @brief Column index by name, -1 when the column is not exist.
+  virtual int FindColumnIndex(const std::string& column_name) const = 0;
+
+  virtual FieldStatus TryAsImpl_int16_t(const int& row, const int& index,
+                                        int16_t& value) const = 0;
+  virtual FieldStatus TryAsImpl_int32_t(const int& row, const int& index,
+                                        int32_t& value) const = 0;
+  virtual FieldStatus TryAsImpl_int64_t(const int& row, const int& index,
+                                        int64_t& value) const = 0;
+  virtual FieldStatus TryAsImpl_string(const int& row, const int& index,
+                                       std::string& value) const = 0;
+  virtual FieldStatus TryAsImpl_float(const int& row, const int& index,
+                                      float& value) const = 0;
+  virtual FieldStatus TryAsImpl_double(const int& row, const int& index,
+                                       double& value) const = 0;
+
  private:
   StorageType type_;
+
+  ColumnSet MaterializeColumns(const std::vector<int>& indices,
+                               const nvm::threads::TaskPoolPtr& pool,
+                               size_t min_chunk_rows) const;
 };
 
 class Cursor {
@@ -76,4 +201,93 @@ class Cursor {
   const ExecutionResult& exec_result_;
 };
 
-NVSERV_END_NAMESPACE
\ No newline at end of file
+namespace impl {
+
+template <typename TFields, std::size_t... Is>
+inline ColumnBinding BindModel(const ExecutionResult& result,
+                               const TFields& fields,
+                               std::index_sequence<Is...>) {
+  return ColumnBinding(
+      result, {std::string(std::get<Is>(fields).name)...},
+      {ColumnReadTypeOf<
+          typename std::tuple_element_t<Is, TFields>::Type>()...});
+}
+
+template <typename T>
+inline T DecodeField(const RowView& row, int index, bool local_time) {
+  if constexpr (is_type_v<T, nvm::dates::DateTime>) {
+    return local_time ? row.AsDateTime<T>(index)
+                      : row.AsDateTimeOffset<T>(index);
+  } else {
+    return row.As<T>(index);
+  }
+}
+
+template <typename TModel, typename TFields, std::size_t N, std::size_t... Is>
+inline void DecodeModel(const RowView& row, const TFields& fields,
+                        const ColumnBinding& binding,
+                        const std::array<bool, N>& local_time, TModel& model,
+                        std::index_sequence<Is...>) {
+  ((model.*(std::get<Is>(fields).member) =
+        DecodeField<typename std::tuple_element_t<Is, TFields>::Type>(
+            row, binding[Is], local_time[Is])),
+   ...);
+}
+
+}  // namespace impl
+
+template <typename TModel>
+std::vector<TModel> ExecutionResult::ToVector() const {
+  return ToVector<TModel>(nullptr);
+}
+
+template <typename TModel>
+std::vector<TModel> ExecutionResult::ToVector(
+    const nvm::threads::TaskPoolPtr& pool, size_t min_chunk_rows) const {
+  static_assert(is_mapped_model_v<TModel>,
+                "ToVector<TModel>, declare the fields with NVQL_MAP");
+
+  const auto fields = NvqlModelFields(static_cast<const TModel*>(nullptr));
+  using Fields = std::remove_const_t<decltype(fields)>;
+  constexpr auto size = std::tuple_size_v<Fields>;
+  constexpr auto sequence = std::make_index_sequence<size>{};
+
+  auto binding = impl::BindModel(*this, fields, sequence);
+
+  // Timestamp without time zone is decoded as local DateTime
+  std::array<bool, size> local_time{};
+  for (size_t i = 0; i < size; i++) {
+    auto type = ColumnType(binding[i]);
+    local_time[i] =
+        type.has_value() && type.value() == parameters::DataType::Timestamp;
+  }
+
+  std::vector<TModel> models;
+  auto rows = static_cast<size_t>(RowCount());
+  if (!pool) {
+    models.reserve(rows);
+    for (size_t row = 0; row < rows; row++) {
+      auto& model = models.emplace_back();
+      impl::DecodeModel(RowView(*this, static_cast<int>(row)), fields,
+                        binding, local_time, model, sequence);
+    }
+    return models;
+  }
+
+  // Pre-sized output, every chunk writes its own row range
+  models.resize(rows);
+  auto chunks = ParallelChunkCount(rows, min_chunk_rows);
+  auto chunk_rows = (rows + chunks - 1) / chunks;
+  ParallelChunks(pool, chunks, [&](size_t chunk) {
+    auto begin = chunk * chunk_rows;
+    auto end = std::min(rows, begin + chunk_rows);
+    for (size_t row = begin; row < end; row++) {
+      impl::DecodeModel(RowView(*this, static_cast<int>(row)), fields,
+                        binding, local_time, models[row], sequence);
+    }
+  });
+
+  return models;
+}
+
+NVSERV_END_NAMESPACE
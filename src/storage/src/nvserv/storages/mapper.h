@@ -29,8 +29,11 @@
 #include <vector>
 
 #include "nvserv/global_macro.h"
+#include "nvserv/storages/column_binding.h"
 #include "nvserv/storages/declare.h"
 #include "nvserv/storages/row_result.h"
+#include "nvserv/storages/row_view.h"
+
 NVSERV_BEGIN_NAMESPACE(storages)
 namespace Mapper {
 
@@ -57,6 +60,15 @@ inline T GetValue(const std::shared_ptr<RowResult> row,
   return row->As<T>(column_name);
 }
 
+// Bound columns, indices resolved once per result
+template <typename Tuple, typename TRow, std::size_t... Is>
+inline auto MakeTupleFromBinding(const TRow& row, const ColumnBinding& binding,
+                                 std::index_sequence<Is...>) {
+  return std::make_tuple(
+      row.template As<typename std::tuple_element<Is, Tuple>::type>(
+          binding[Is])...);
+}
+
 // Helper to map tuple to model
 template <typename TModel, typename TTuple, std::size_t... Is>
 inline TModel MapImpl(const TTuple& tuple, std::index_sequence<Is...>) {
@@ -73,6 +85,20 @@ inline auto Dynamic(const std::shared_ptr<RowResult> row,
       row, column_names, std::index_sequence_for<Args...>{});
 }
 
+// Create a tuple from a row & columns resolved once by ColumnBinding
+template <typename... Args>
+inline auto Dynamic(const std::shared_ptr<RowResult> row,
+                    const ColumnBinding& binding) {
+  return impl::MakeTupleFromBinding<std::tuple<Args...>>(
+      *row, binding, std::index_sequence_for<Args...>{});
+}
+
+template <typename... Args>
+inline auto Dynamic(const RowView& row, const ColumnBinding& binding) {
+  return impl::MakeTupleFromBinding<std::tuple<Args...>>(
+      row, binding, std::index_sequence_for<Args...>{});
+}
+
 // Function to map tuple to model
 template <typename TModel, typename TTuple>
 inline TModel Map(const TTuple& tuple) {
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "nvserv/global_macro.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/// @brief Column-to-member binding of a model declared by NVQL_MAP.
+template <typename TModel, typename TField>
+struct ModelField {
+  using Type = TField;
+
+  const char* name;
+  TField TModel::*member;
+};
+
+template <typename TModel, typename TField>
+constexpr ModelField<TModel, TField> MakeModelField(const char* name,
+                                                    TField TModel::*member) {
+  return ModelField<TModel, TField>{name, member};
+}
+
+namespace impl {
+
+template <typename TModel, typename = void>
+struct IsMappedModel : std::false_type {};
+
+// NvqlModelFields is found by ADL in the namespace of the model
+template <typename TModel>
+struct IsMappedModel<TModel, std::void_t<decltype(NvqlModelFields(
+                                 static_cast<const TModel*>(nullptr)))>>
+                : std::true_type {};
+
+}  // namespace impl
+
+/// @brief Model has the field list declared by NVQL_MAP.
+template <typename TModel>
+constexpr bool is_mapped_model_v = impl::IsMappedModel<TModel>::value;
+
+NVSERV_END_NAMESPACE
+
+/// @brief Declare the fields of a model, mapped to the columns of the same
+/// name, for ExecutionResult::ToVector<TModel>().
+/// Use at the namespace of the model, up to 32 fields.
+///
+/// @code
+/// struct User {
+///   int32_t user_id;
+///   std::string username;
+///   int16_t status;
+/// };
+/// NVQL_MAP(User, user_id, username, status)
+/// @endcode
+#define NVQL_MAP(TYPE, ...)                                                    \
+  [[maybe_unused]] inline auto NvqlModelFields(const TYPE*) {                  \
+    return std::make_tuple(NVQL_MAP_EXPAND(NVQL_MAP_CAT(                       \
+        NVQL_MAP_F_, NVQL_MAP_COUNT(__VA_ARGS__))(TYPE, __VA_ARGS__)));        \
+  }
+
+#define NVQL_MAP_EXPAND(x) x
+#define NVQL_MAP_CAT(a, b) NVQL_MAP_CAT_(a, b)
+#define NVQL_MAP_CAT_(a, b) a##b
+
+#define NVQL_MAP_FIELD(T, F) ::nvserv::storages::MakeModelField(#F, &T::F)
+
+#define NVQL_MAP_COUNT(...)                                                    \
+  NVQL_MAP_EXPAND(NVQL_MAP_COUNT_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, \
+                                  24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14,  \
+                                  13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define NVQL_MAP_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12,     \
+                        _13, _14, _15, _16, _17, _18, _19, _20, _21, _22,      \
+                        _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N,   \
+                        ...)                                                   \
+  N
+
+#define NVQL_MAP_F_1(T, F) NVQL_MAP_FIELD(T, F)
+#define NVQL_MAP_F_2(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_1(T, __VA_ARGS__))
+#define NVQL_MAP_F_3(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_2(T, __VA_ARGS__))
+#define NVQL_MAP_F_4(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_3(T, __VA_ARGS__))
+#define NVQL_MAP_F_5(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_4(T, __VA_ARGS__))
+#define NVQL_MAP_F_6(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_5(T, __VA_ARGS__))
+#define NVQL_MAP_F_7(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_6(T, __VA_ARGS__))
+#define NVQL_MAP_F_8(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_7(T, __VA_ARGS__))
+#define NVQL_MAP_F_9(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_8(T, __VA_ARGS__))
+#define NVQL_MAP_F_10(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_9(T, __VA_ARGS__))
+#define NVQL_MAP_F_11(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_10(T, __VA_ARGS__))
+#define NVQL_MAP_F_12(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_11(T, __VA_ARGS__))
+#define NVQL_MAP_F_13(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_12(T, __VA_ARGS__))
+#define NVQL_MAP_F_14(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_13(T, __VA_ARGS__))
+#define NVQL_MAP_F_15(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_14(T, __VA_ARGS__))
+#define NVQL_MAP_F_16(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_15(T, __VA_ARGS__))
+#define NVQL_MAP_F_17(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_16(T, __VA_ARGS__))
+#define NVQL_MAP_F_18(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_17(T, __VA_ARGS__))
+#define NVQL_MAP_F_19(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_18(T, __VA_ARGS__))
+#define NVQL_MAP_F_20(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_19(T, __VA_ARGS__))
+#define NVQL_MAP_F_21(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_20(T, __VA_ARGS__))
+#define NVQL_MAP_F_22(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_21(T, __VA_ARGS__))
+#define NVQL_MAP_F_23(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_22(T, __VA_ARGS__))
+#define NVQL_MAP_F_24(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_23(T, __VA_ARGS__))
+#define NVQL_MAP_F_25(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_24(T, __VA_ARGS__))
+#define NVQL_MAP_F_26(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_25(T, __VA_ARGS__))
+#define NVQL_MAP_F_27(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_26(T, __VA_ARGS__))
+#define NVQL_MAP_F_28(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_27(T, __VA_ARGS__))
+#define NVQL_MAP_F_29(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_28(T, __VA_ARGS__))
+#define NVQL_MAP_F_30(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_29(T, __VA_ARGS__))
+#define NVQL_MAP_F_31(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_30(T, __VA_ARGS__))
+#define NVQL_MAP_F_32(T, F, ...) \
+  NVQL_MAP_FIELD(T, F), NVQL_MAP_EXPAND(NVQL_MAP_F_31(T, __VA_ARGS__))
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/parallel_decode.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "nvserv/headers/absl_thread.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+namespace {
+
+// Shared with the helper tasks, may outlive the caller
+class ChunkState {
+ public:
+  ChunkState(size_t chunks, std::function<void(size_t)> func)
+                  : chunks_(chunks),
+                    func_(std::move(func)),
+                    next_(0),
+                    done_(0),
+                    error_(nullptr) {}
+
+  void Run() {
+    size_t chunk;
+    while ((chunk = next_.fetch_add(1, std::memory_order_relaxed)) <
+           chunks_) {
+      std::exception_ptr error = nullptr;
+      try {
+        func_(chunk);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      absl::MutexLock lock(&mutex_);
+      if (error && !error_) {
+        error_ = error;
+      }
+      done_++;
+    }
+  }
+
+  void Wait() {
+    absl::MutexLock lock(&mutex_);
+    mutex_.Await(absl::Condition(this, &ChunkState::IsDone));
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+ private:
+  size_t chunks_;
+  std::function<void(size_t)> func_;
+  std::atomic<size_t> next_;
+  absl::Mutex mutex_;
+  size_t done_;
+  std::exception_ptr error_;
+
+  bool IsDone() const {
+    return done_ == chunks_;
+  }
+};
+
+}  // namespace
+
+size_t ParallelChunkCount(size_t rows, size_t min_chunk_rows) {
+  if (min_chunk_rows == 0) {
+    min_chunk_rows = DEFAULT_PARALLEL_CHUNK_ROWS;
+  }
+  size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  size_t chunks = (rows + min_chunk_rows - 1) / min_chunk_rows;
+  return std::max<size_t>(1, std::min(chunks, threads));
+}
+
+void ParallelChunks(const nvm::threads::TaskPoolPtr& pool, size_t chunks,
+                    std::function<void(size_t)> func) {
+  if (chunks == 0) {
+    return;
+  }
+
+  if (!pool || chunks == 1) {
+    for (size_t i = 0; i < chunks; i++) {
+      func(i);
+    }
+    return;
+  }
+
+  auto state = std::make_shared<ChunkState>(chunks, std::move(func));
+  for (size_t i = 1; i < chunks; i++) {
+    pool->ExecuteTask([state]() { state->Run(); });
+  }
+
+  state->Run();
+  state->Wait();
+}
+
+NVSERV_END_NAMESPACE
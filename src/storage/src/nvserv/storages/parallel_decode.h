@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <nvm/threads/task_pool.h>
+
+#include <cstddef>
+#include <functional>
+
+#include "nvserv/global_macro.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/// @brief Rows per chunk below which decoding stays on the caller thread.
+constexpr size_t DEFAULT_PARALLEL_CHUNK_ROWS = 16384;
+
+/// @brief Number of chunks for rows, at least min_chunk_rows per chunk and
+/// at most one chunk per hardware thread.
+size_t ParallelChunkCount(size_t rows, size_t min_chunk_rows);
+
+/// @brief Run func(chunk) for chunk in [0, chunks) on the TaskPool & the
+/// caller thread, returns when every chunk is done and rethrows the first
+/// exception. Chunks are claimed from a shared counter and the caller only
+/// waits for claimed chunks, so calling it from a TaskPool worker can't
+/// deadlock on helpers that never got a worker. Runs inline without pool.
+void ParallelChunks(const nvm::threads::TaskPoolPtr& pool, size_t chunks,
+                    std::function<void(size_t)> func);
+
+NVSERV_END_NAMESPACE
@@ -44,6 +44,22 @@ Param::Param(const std::chrono::system_clock::time_point& value)
                 : data_(std::cref(value)), type_(DataType::Timestamp) {}
 Param::Param(const NvDateTime& value)
                 : data_(std::cref(value)), type_(DataType::Timestampz) {}
+Param::Param(const std::vector<unsigned char>& value)
+                : data_(std::cref(value)), type_(DataType::Bytea) {}
+Param::Param(const std::array<unsigned char, 16>& value)
+                : data_(std::cref(value)), type_(DataType::Uuid) {}
+Param::Param(const std::vector<int16_t>& value)
+                : data_(std::cref(value)), type_(DataType::SmallIntArray) {}
+Param::Param(const std::vector<int32_t>& value)
+                : data_(std::cref(value)), type_(DataType::IntArray) {}
+Param::Param(const std::vector<int64_t>& value)
+                : data_(std::cref(value)), type_(DataType::BigIntArray) {}
+Param::Param(const std::vector<double>& value)
+                : data_(std::cref(value)), type_(DataType::DoubleArray) {}
+Param::Param(const std::vector<float>& value)
+                : data_(std::cref(value)), type_(DataType::RealArray) {}
+Param::Param(const std::vector<std::string>& value)
+                : data_(std::cref(value)), type_(DataType::StringArray) {}
 
 Param Param::SmallInt(const int16_t& value) {
   return Param(value);
@@ -81,6 +97,38 @@ Param Param::Timestampz(const NvDateTime& value) {
   return Param(value);
 }
 
+Param Param::Bytea(const std::vector<unsigned char>& value) {
+  return Param(value);
+}
+
+Param Param::Uuid(const std::array<unsigned char, 16>& value) {
+  return Param(value);
+}
+
+Param Param::SmallIntArray(const std::vector<int16_t>& value) {
+  return Param(value);
+}
+
+Param Param::IntArray(const std::vector<int32_t>& value) {
+  return Param(value);
+}
+
+Param Param::BigIntArray(const std::vector<int64_t>& value) {
+  return Param(value);
+}
+
+Param Param::DoubleArray(const std::vector<double>& value) {
+  return Param(value);
+}
+
+Param Param::RealArray(const std::vector<float>& value) {
+  return Param(value);
+}
+
+Param Param::StringArray(const std::vector<std::string>& value) {
+  return Param(value);
+}
+
 DataType Param::Type() const {
   return type_;
 }
@@ -21,9 +21,12 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "nvserv/global_macro.h"
 
@@ -45,7 +48,13 @@ using NvQLVType = std::variant<
     std::reference_wrapper<const NvDateTime>,          // Timestamp offset
     std::reference_wrapper<const std::vector<unsigned char>>,    // Binary data
                                                                  // type
-    std::reference_wrapper<const std::array<unsigned char, 16>>  // UUID type
+    std::reference_wrapper<const std::array<unsigned char, 16>>,  // UUID type
+    std::reference_wrapper<const std::vector<int16_t>>,      // Small Int[]
+    std::reference_wrapper<const std::vector<int32_t>>,      // Integer[]
+    std::reference_wrapper<const std::vector<int64_t>>,      // Bigint[]
+    std::reference_wrapper<const std::vector<double>>,       // Double[]
+    std::reference_wrapper<const std::vector<float>>,        // Real[]
+    std::reference_wrapper<const std::vector<std::string>>   // Text[]
     >;
 
 enum class DataType {
@@ -59,7 +68,15 @@ enum class DataType {
   Date,
   Time,
   Timestamp,
-  Timestampz
+  Timestampz,
+  Bytea,
+  Uuid,
+  SmallIntArray,
+  IntArray,
+  BigIntArray,
+  RealArray,
+  DoubleArray,
+  StringArray
 };
 
 class Param {
@@ -73,6 +90,14 @@ class Param {
   explicit Param(const bool& value);
   explicit Param(const std::chrono::system_clock::time_point& value);
   explicit Param(const NvDateTime& value);
+  explicit Param(const std::vector<unsigned char>& value);
+  explicit Param(const std::array<unsigned char, 16>& value);
+  explicit Param(const std::vector<int16_t>& value);
+  explicit Param(const std::vector<int32_t>& value);
+  explicit Param(const std::vector<int64_t>& value);
+  explicit Param(const std::vector<double>& value);
+  explicit Param(const std::vector<float>& value);
+  explicit Param(const std::vector<std::string>& value);
 
   static Param SmallInt(const int16_t& value);
   static Param Int(const int32_t& value);
@@ -83,16 +108,22 @@ class Param {
   static Param Bool(const bool& value);
   static Param Timestamp(const std::chrono::system_clock::time_point& value);
   static Param Timestampz(const NvDateTime& value);
+  static Param Bytea(const std::vector<unsigned char>& value);
+  static Param Uuid(const std::array<unsigned char, 16>& value);
+
+  /// @brief One-dimensional array, one parameter for any list length,
+  /// e.g. `WHERE id = ANY($1)` or `unnest($1)`.
+  static Param SmallIntArray(const std::vector<int16_t>& value);
+  static Param IntArray(const std::vector<int32_t>& value);
+  static Param BigIntArray(const std::vector<int64_t>& value);
+  static Param DoubleArray(const std::vector<double>& value);
+  static Param RealArray(const std::vector<float>& value);
+  static Param StringArray(const std::vector<std::string>& value);
 
   // explicit Param(const char* value)
   //                 : data_(std::cref(std::string(value))),
   //                   type_(DataType::String) {}
 
-  // explicit Param(const std::vector<unsigned char>& value)
-  //                 : data_(std::cref(value)), type_(DataType::Date) {}
-  // explicit Param(const std::array<unsigned char, 16>& value)
-  //                 : data_(std::cref(value)), type_(DataType::Date) {}
-
   DataType Type() const;
   template <typename T>
   const T& As() const;
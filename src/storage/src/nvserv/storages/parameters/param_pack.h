@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/parameters/param.h"
+
+NVSERV_BEGIN_NAMESPACE(storages)
+
+namespace parameters {
+
+/// @brief Non-owning view of contiguous parameters, from ParameterArgs,
+/// a std::array of Param or ParamPack. Used by the execution paths so the
+/// parameters are never copied into a container on the way to the driver.
+class ParamView {
+ public:
+  ParamView() : data_(nullptr), size_(0) {}
+
+  ParamView(const Param* data, size_t size) : data_(data), size_(size) {}
+
+  // cppcheck-suppress noExplicitConstructor
+  ParamView(const ParameterArgs& args)
+                  : data_(args.data()), size_(args.size()) {}
+
+  template <size_t N>
+  // cppcheck-suppress noExplicitConstructor
+  ParamView(const std::array<Param, N>& args)
+                  : data_(args.data()), size_(N) {}
+
+  const Param* begin() const {
+    return data_;
+  }
+
+  const Param* end() const {
+    return data_ + size_;
+  }
+
+  const Param& operator[](size_t index) const {
+    return data_[index];
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+ private:
+  const Param* data_;
+  size_t size_;
+};
+
+namespace impl {
+
+// String literals are owned as std::string
+template <typename T>
+using ParamStorageT = std::conditional_t<
+    std::is_same_v<std::decay_t<T>, const char*> ||
+        std::is_same_v<std::decay_t<T>, char*>,
+    std::string, std::decay_t<T>>;
+
+inline Param ToParam(const Param& param) {
+  return param;
+}
+
+template <typename T>
+Param ToParam(const T& value) {
+  // Pointers would silently bind to Param(bool)
+  static_assert(!std::is_pointer_v<std::decay_t<T>>,
+                "Pass std::string or use MakeParams for string literals");
+  return Param(value);
+}
+
+}  // namespace impl
+
+/// @brief Fixed-capacity parameter pack that owns its values inline,
+/// so temporaries can't dangle and no container is allocated.
+/// Params reference the owned values, the pack is neither copyable nor
+/// movable; create it in place with MakeParams or CTAD.
+///
+/// @code
+/// auto params = MakeParams(user_id, std::string("active"), "2024-01-01");
+/// auto result = tx->Execute(query, params);
+/// @endcode
+template <typename... Ts>
+class ParamPack {
+ public:
+  template <typename... Us>
+  explicit ParamPack(Us&&... values)
+                  : ParamPack(std::index_sequence_for<Ts...>{},
+                              std::forward<Us>(values)...) {}
+
+  ParamPack(const ParamPack&) = delete;
+  ParamPack& operator=(const ParamPack&) = delete;
+
+  ParamView View() const {
+    return ParamView(params_);
+  }
+
+  // cppcheck-suppress noExplicitConstructor
+  operator ParamView() const {
+    return View();
+  }
+
+  constexpr size_t Size() const {
+    return sizeof...(Ts);
+  }
+
+  const Param& operator[](size_t index) const {
+    return params_[index];
+  }
+
+ private:
+  std::tuple<Ts...> values_;
+  std::array<Param, sizeof...(Ts)> params_;
+
+  template <size_t... Is, typename... Us>
+  explicit ParamPack(std::index_sequence<Is...>, Us&&... values)
+                  : values_(std::forward<Us>(values)...),
+                    params_{{impl::ToParam(std::get<Is>(values_))...}} {}
+};
+
+template <typename... Us>
+ParamPack(Us&&...) -> ParamPack<impl::ParamStorageT<Us>...>;
+
+/// @brief Owning ParamPack of the values, see ParamPack.
+template <typename... Us>
+ParamPack<impl::ParamStorageT<Us>...> MakeParams(Us&&... values) {
+  return ParamPack<impl::ParamStorageT<Us>...>(std::forward<Us>(values)...);
+}
+
+}  // namespace parameters
+
+NVSERV_END_NAMESPACE
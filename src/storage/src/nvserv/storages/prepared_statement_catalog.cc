@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/prepared_statement_catalog.h"
+
+#include "nvserv/storages/exceptions.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/* PreparedStatementCatalog */
+
+PreparedStatementCatalog::PreparedStatementCatalog(bool adaptive_plan)
+                : entries_(), ids_(), warmup_(), adaptive_plan_(adaptive_plan) {}
+
+PreparedStatementCatalog::~PreparedStatementCatalog() {}
+
+StatementId PreparedStatementCatalog::Intern(
+    const __NR_STRING_COMPAT_REF query) {
+  std::string_view view(query);
+  {
+    absl::ReaderMutexLock lock(&mutex_);
+    auto it = ids_.find(view);
+    if (it != ids_.end()) {
+      return it->second;
+    }
+  }
+
+  absl::MutexLock lock(&mutex_);
+  // Registered by another thread meanwhile
+  auto it = ids_.find(view);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+
+  auto id = static_cast<StatementId>(entries_.size());
+  entries_.emplace_back(std::string(view), "nvql_" + std::to_string(id));
+  ids_.emplace(std::string_view(entries_.back().query), id);
+
+  return id;
+}
+
+std::optional<StatementId> PreparedStatementCatalog::Find(
+    const __NR_STRING_COMPAT_REF query) const {
+  absl::ReaderMutexLock lock(&mutex_);
+  auto it = ids_.find(std::string_view(query));
+  if (it == ids_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+const std::string& PreparedStatementCatalog::Name(StatementId id) const {
+  return At(id).name;
+}
+
+const std::string& PreparedStatementCatalog::Query(StatementId id) const {
+  return At(id).query;
+}
+
+size_t PreparedStatementCatalog::Size() const {
+  absl::ReaderMutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+void PreparedStatementCatalog::RecordHit(StatementId id) {
+  At(id).hits.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PreparedStatementCatalog::RecordMiss(StatementId id) {
+  At(id).misses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PreparedStatementCatalog::RecordEviction(StatementId id) {
+  At(id).evictions.fetch_add(1, std::memory_order_relaxed);
+}
+
+PreparedStatementStats PreparedStatementCatalog::Stats(StatementId id) const {
+  return ToStats(id, At(id));
+}
+
+std::vector<PreparedStatementStats> PreparedStatementCatalog::Stats() const {
+  absl::ReaderMutexLock lock(&mutex_);
+  std::vector<PreparedStatementStats> stats;
+  stats.reserve(entries_.size());
+  for (size_t i = 0; i < entries_.size(); i++) {
+    stats.emplace_back(ToStats(static_cast<StatementId>(i), entries_[i]));
+  }
+  return stats;
+}
+
+bool PreparedStatementCatalog::IsAdaptivePlan() const {
+  return adaptive_plan_;
+}
+
+PlanChoice PreparedStatementCatalog::ChoosePlan(StatementId id) {
+  if (!adaptive_plan_) {
+    return PlanChoice::Prepared;
+  }
+
+  auto& entry = At(id);
+  auto plan = entry.plan.load(std::memory_order_relaxed);
+  auto n = entry.executions.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (n % PLAN_EXPLORE_INTERVAL == 0) {
+    return plan == PlanChoice::Prepared ? PlanChoice::NonPrepared
+                                        : PlanChoice::Prepared;
+  }
+
+  return plan;
+}
+
+void PreparedStatementCatalog::RecordLatency(
+    StatementId id, PlanChoice plan, std::chrono::microseconds elapsed) {
+  if (!adaptive_plan_) {
+    return;
+  }
+
+  auto& entry = At(id);
+  auto path = static_cast<size_t>(plan);
+  auto sample = static_cast<double>(elapsed.count());
+
+  // Racing updates may drop a sample, good enough for an average
+  auto samples = entry.samples[path].fetch_add(1, std::memory_order_relaxed);
+  auto average = entry.latency[path].load(std::memory_order_relaxed);
+  entry.latency[path].store(
+      samples == 0 ? sample
+                   : average + PLAN_LATENCY_ALPHA * (sample - average),
+      std::memory_order_relaxed);
+
+  if (entry.samples[0].load(std::memory_order_relaxed) < PLAN_MIN_SAMPLES ||
+      entry.samples[1].load(std::memory_order_relaxed) < PLAN_MIN_SAMPLES) {
+    return;
+  }
+
+  auto current = entry.plan.load(std::memory_order_relaxed);
+  auto other = current == PlanChoice::Prepared ? PlanChoice::NonPrepared
+                                               : PlanChoice::Prepared;
+  auto current_latency =
+      entry.latency[static_cast<size_t>(current)].load(
+          std::memory_order_relaxed);
+  auto other_latency = entry.latency[static_cast<size_t>(other)].load(
+      std::memory_order_relaxed);
+
+  if (other_latency < current_latency * (1.0 - PLAN_SWITCH_MARGIN)) {
+    entry.plan.store(other, std::memory_order_relaxed);
+  }
+}
+
+void PreparedStatementCatalog::AddWarmup(StatementId id,
+                                         std::vector<uint32_t> param_types) {
+  At(id);  // validates the id
+
+  absl::MutexLock lock(&mutex_);
+  for (const auto& statement : warmup_) {
+    if (statement.id == id) {
+      return;
+    }
+  }
+
+  WarmupStatement statement;
+  statement.id = id;
+  statement.param_types = std::move(param_types);
+  warmup_.emplace_back(std::move(statement));
+}
+
+std::vector<WarmupStatement> PreparedStatementCatalog::Warmup() const {
+  absl::ReaderMutexLock lock(&mutex_);
+  return warmup_;
+}
+
+const std::vector<uint32_t>* PreparedStatementCatalog::ParamTypes(
+    StatementId id) const {
+  const auto& entry = At(id);
+  return entry.typed.load(std::memory_order_acquire) ? &entry.param_types
+                                                     : nullptr;
+}
+
+const std::vector<uint32_t>& PreparedStatementCatalog::RecordParamTypes(
+    StatementId id, std::vector<uint32_t> param_types) {
+  auto& entry = At(id);
+
+  absl::MutexLock lock(&mutex_);
+  if (!entry.typed.load(std::memory_order_relaxed)) {
+    entry.param_types = std::move(param_types);
+    entry.typed.store(true, std::memory_order_release);
+  }
+  return entry.param_types;
+}
+
+// private:
+
+const PreparedStatementCatalog::Entry& PreparedStatementCatalog::At(
+    StatementId id) const {
+  absl::ReaderMutexLock lock(&mutex_);
+  if (id >= entries_.size()) {
+    throw InvalidArgException("Unknown prepared statement id: " +
+                              std::to_string(id));
+  }
+  return entries_[id];
+}
+
+PreparedStatementCatalog::Entry& PreparedStatementCatalog::At(StatementId id) {
+  absl::ReaderMutexLock lock(&mutex_);
+  if (id >= entries_.size()) {
+    throw InvalidArgException("Unknown prepared statement id: " +
+                              std::to_string(id));
+  }
+  return entries_[id];
+}
+
+// static
+PreparedStatementStats PreparedStatementCatalog::ToStats(StatementId id,
+                                                         const Entry& entry) {
+  PreparedStatementStats stats;
+  stats.id = id;
+  stats.query = entry.query;
+  stats.hits = entry.hits.load(std::memory_order_relaxed);
+  stats.misses = entry.misses.load(std::memory_order_relaxed);
+  stats.evictions = entry.evictions.load(std::memory_order_relaxed);
+  stats.prepared_latency_us = entry.latency[0].load(std::memory_order_relaxed);
+  stats.non_prepared_latency_us =
+      entry.latency[1].load(std::memory_order_relaxed);
+  stats.plan = entry.plan.load(std::memory_order_relaxed);
+  return stats;
+}
+
+/* PreparedStatementCatalog::Entry */
+
+PreparedStatementCatalog::Entry::Entry(std::string query, std::string name)
+                : query(std::move(query)),
+                  name(std::move(name)),
+                  hits(0),
+                  misses(0),
+                  evictions(0),
+                  executions(0),
+                  plan(PlanChoice::Prepared),
+                  latency{0.0, 0.0},
+                  samples{0, 0},
+                  param_types(),
+                  typed(false) {}
+
+/* PreparedStatementKey */
+
+PreparedStatementKey::PreparedStatementKey(StatementId id,
+                                           const std::string& name,
+                                           bool is_new, bool is_stale,
+                                           const std::string* evicted_name,
+                                           StatementId evicted_id)
+                : id_(id),
+                  name_(&name),
+                  is_new_(is_new),
+                  is_stale_(is_stale),
+                  evicted_name_(evicted_name),
+                  evicted_id_(evicted_id) {}
+
+StatementId PreparedStatementKey::Id() const {
+  return id_;
+}
+
+const std::string& PreparedStatementKey::Name() const {
+  return *name_;
+}
+
+bool PreparedStatementKey::IsNew() const {
+  return is_new_;
+}
+
+bool PreparedStatementKey::IsStale() const {
+  return is_stale_;
+}
+
+bool PreparedStatementKey::HasEvicted() const {
+  return evicted_name_ != nullptr;
+}
+
+const std::string& PreparedStatementKey::EvictedName() const {
+  return *evicted_name_;
+}
+
+StatementId PreparedStatementKey::EvictedId() const {
+  return evicted_id_;
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nvserv/global_macro.h"
+#include "nvserv/headers/absl_thread.h"
+#include "nvserv/storages/declare.h"
+
+NVSERV_BEGIN_NAMESPACE(storages)
+
+using StatementId = uint32_t;
+
+/// @brief Execution path of a statement.
+enum class PlanChoice : uint8_t {
+  // Prepared statement, server may settle on a generic plan
+  Prepared = 0,
+  // Unnamed statement, planned for the actual parameter values
+  NonPrepared = 1
+};
+
+/// @brief Usage counters of one statement across all connections.
+struct PreparedStatementStats {
+  StatementId id = 0;
+  std::string query;
+  // Executed on a connection that already prepared it
+  uint64_t hits = 0;
+  // Needed a PREPARE round trip first
+  uint64_t misses = 0;
+  // Deallocated by the per-connection LRU
+  uint64_t evictions = 0;
+  // Average latency (EWMA) of each path, 0 until sampled
+  double prepared_latency_us = 0;
+  double non_prepared_latency_us = 0;
+  PlanChoice plan = PlanChoice::Prepared;
+
+  /// @brief Low ratio means the statement is rarely reused,
+  /// candidate for ExecuteNonPrepared.
+  double HitRatio() const {
+    auto total = hits + misses;
+    return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+  }
+};
+
+/// @brief Statement prepared on every connection as soon as it is opened.
+struct WarmupStatement {
+  StatementId id = 0;
+  // Parameter type OIDs, empty lets the server infer them
+  std::vector<uint32_t> param_types;
+};
+
+/// @brief Pool-wide interned SQL statements.
+/// Each distinct SQL is stored once and gets a stable sequential id,
+/// its prepared statement name ("nvql_<id>") is derived from the id
+/// so names never collide. Entries are never removed, references returned
+/// by Name()/Query() stay valid for the catalog lifetime.
+/// The catalog thus grows with every distinct SQL, and with it the
+/// per-connection bitsets of PreparedStatementManager; the prepared
+/// statement capacity doesn't bound it. Dynamic SQL (inlined values) must
+/// bypass it with ExecuteNonPrepared.
+///
+/// With adaptive plan, the latency of both execution paths is tracked per
+/// statement and ChoosePlan() routes to the faster one. Postgres may switch
+/// a prepared statement to a generic plan that is bad for skewed values,
+/// the non-prepared path is planned for the actual values on every call.
+/// The other path is still sampled periodically so the choice switches
+/// back when it improves.
+class PreparedStatementCatalog {
+ public:
+  // Every n-th execution samples the path not currently chosen
+  static constexpr uint64_t PLAN_EXPLORE_INTERVAL = 32;
+  // Samples required on both paths before the choice can switch
+  static constexpr uint32_t PLAN_MIN_SAMPLES = 4;
+  // Other path must be faster by this ratio to switch (hysteresis)
+  static constexpr double PLAN_SWITCH_MARGIN = 0.2;
+  // EWMA smoothing factor of the latency
+  static constexpr double PLAN_LATENCY_ALPHA = 0.2;
+
+  explicit PreparedStatementCatalog(bool adaptive_plan = false);
+
+  ~PreparedStatementCatalog();
+
+  /// @brief Id of the query, registered when not yet known.
+  StatementId Intern(const __NR_STRING_COMPAT_REF query);
+
+  std::optional<StatementId> Find(const __NR_STRING_COMPAT_REF query) const;
+
+  const std::string& Name(StatementId id) const;
+
+  const std::string& Query(StatementId id) const;
+
+  size_t Size() const;
+
+  void RecordHit(StatementId id);
+
+  void RecordMiss(StatementId id);
+
+  void RecordEviction(StatementId id);
+
+  PreparedStatementStats Stats(StatementId id) const;
+
+  /// @brief Counters of all statements, ordered by id.
+  std::vector<PreparedStatementStats> Stats() const;
+
+  bool IsAdaptivePlan() const;
+
+  /// @brief Path of the next execution, always Prepared
+  /// unless adaptive plan is enabled.
+  PlanChoice ChoosePlan(StatementId id);
+
+  /// @brief Feed the latency of a completed execution,
+  /// excluding PREPARE round trip.
+  void RecordLatency(StatementId id, PlanChoice plan,
+                     std::chrono::microseconds elapsed);
+
+  /// @brief Add the statement to the warm-up manifest,
+  /// applied to connections opened afterwards.
+  void AddWarmup(StatementId id, std::vector<uint32_t> param_types = {});
+
+  /// @brief Warm-up manifest in registration order.
+  std::vector<WarmupStatement> Warmup() const;
+
+  /// @brief Parameter type OIDs the statement is prepared with on every
+  /// connection, null until recorded. Empty or 0 entries are inferred by
+  /// the server, their values must be sent as text.
+  const std::vector<uint32_t>* ParamTypes(StatementId id) const;
+
+  /// @brief Record the parameter types before the statement is prepared,
+  /// the first caller wins and the recorded ones are returned, so every
+  /// connection prepares the statement alike.
+  const std::vector<uint32_t>& RecordParamTypes(
+      StatementId id, std::vector<uint32_t> param_types);
+
+ private:
+  struct Entry {
+    Entry(std::string query, std::string name);
+
+    std::string query;
+    std::string name;
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> evictions;
+    std::atomic<uint64_t> executions;
+    std::atomic<PlanChoice> plan;
+    std::atomic<double> latency[2];
+    std::atomic<uint32_t> samples[2];
+    // Written once, before `typed` is published
+    std::vector<uint32_t> param_types;
+    std::atomic<bool> typed;
+  };
+
+  // deque never moves its elements, keys are views into entries_
+  std::deque<Entry> entries_;
+  absl::flat_hash_map<std::string_view, StatementId> ids_;
+  std::vector<WarmupStatement> warmup_;
+  bool adaptive_plan_;
+  mutable absl::Mutex mutex_;
+
+  const Entry& At(StatementId id) const;
+
+  Entry& At(StatementId id);
+
+  static PreparedStatementStats ToStats(StatementId id, const Entry& entry);
+};
+
+/// @brief Result of registering statement on a connection.
+class PreparedStatementKey {
+ public:
+  PreparedStatementKey(StatementId id, const std::string& name, bool is_new,
+                       bool is_stale,
+                       const std::string* evicted_name = nullptr,
+                       StatementId evicted_id = 0);
+
+  StatementId Id() const;
+
+  /// @brief Server side prepared statement name, owned by the catalog.
+  const std::string& Name() const;
+
+  /// @brief Not yet prepared on this connection, PREPARE it first.
+  bool IsNew() const;
+
+  /// @brief Plan was invalidated (schema changed),
+  /// DEALLOCATE before PREPARE it again.
+  bool IsStale() const;
+
+  /// @brief Registering this statement evicted the least recently used
+  /// one from the connection, DEALLOCATE it on the server.
+  bool HasEvicted() const;
+
+  const std::string& EvictedName() const;
+
+  StatementId EvictedId() const;
+
+ private:
+  StatementId id_;
+  const std::string* name_;
+  bool is_new_;
+  bool is_stale_;
+  const std::string* evicted_name_;
+  StatementId evicted_id_;
+};
+
+NVSERV_END_NAMESPACE
@@ -24,79 +24,179 @@
 // cppcheck-suppress unknownMacro
 NVSERV_BEGIN_NAMESPACE(storages)
 
-PreparedStatementItem::PreparedStatementItem(
-    const std::string& statement_key, const std::string& name,
-    const std::string& query,
-    const std::chrono::system_clock::time_point& created)
-                : statement_key_(std::string(statement_key)),
-                  name_(std::string(name)),
-                  query_(std::string(query)),
-                  created_time_(
-                      std::chrono::system_clock::time_point(created)) {}
+PreparedStatementManager::PreparedStatementManager(
+    PreparedStatementCatalogPtr catalog, uint32_t capacity)
+                : catalog_(catalog ? std::move(catalog)
+                                   : std::make_shared<PreparedStatementCatalog>()),
+                  prepared_(),
+                  stale_(),
+                  capacity_(capacity),
+                  size_(0),
+                  lru_(),
+                  lru_index_() {};
 
-__NR_STRING_COMPAT_REF PreparedStatementItem::Query() const {
-  return query_;
+PreparedStatementManager::~PreparedStatementManager() {};
+
+std::optional<PreparedStatementKey> PreparedStatementManager::Register(
+    const __NR_STRING_COMPAT_REF query) {
+  // Checked on the view, Register runs on every submitted statement
+  std::string_view view(query);
+  if (view.find_first_not_of(" \t\n\v\f\r") == std::string_view::npos) {
+    return std::nullopt;
+  }
+
+  return Register(catalog_->Intern(query));
 }
 
-const std::string& PreparedStatementItem::Name() const {
-  return name_;
+PreparedStatementKey PreparedStatementManager::Register(StatementId id) {
+  const auto& name = catalog_->Name(id);
+
+  if (Test(stale_, id)) {
+    Set(stale_, id, false);
+    Touch(id);
+    catalog_->RecordMiss(id);
+    return PreparedStatementKey(id, name, true, true);
+  }
+
+  if (Test(prepared_, id)) {
+    Touch(id);
+    catalog_->RecordHit(id);
+    return PreparedStatementKey(id, name, false, false);
+  }
+
+  auto evicted = EvictIfFull();
+  Set(prepared_, id, true);
+  size_++;
+  Touch(id);
+  catalog_->RecordMiss(id);
+  if (!evicted.has_value()) {
+    return PreparedStatementKey(id, name, true, false);
+  }
+  return PreparedStatementKey(id, name, true, false,
+                              &catalog_->Name(evicted.value()),
+                              evicted.value());
 }
 
-const std::string& PreparedStatementItem::Key() const {
-  return statement_key_;
+bool PreparedStatementManager::IsPrepared(StatementId id) const {
+  return Test(prepared_, id);
 }
 
-std::chrono::system_clock::time_point PreparedStatementItem::CreatedTime()
-    const {
-  return created_time_;
+bool PreparedStatementManager::IsQueryExist(const std::string& query) const {
+  auto id = catalog_->Find(query);
+  return id.has_value() && IsPrepared(id.value());
 }
 
-PreparedStatementManager::PreparedStatementManager() {};
-PreparedStatementManager::~PreparedStatementManager() {};
+void PreparedStatementManager::MarkStale(StatementId id) {
+  if (Test(prepared_, id)) {
+    Set(stale_, id, true);
+  }
+}
 
-std::optional<std::pair<std::string, bool>> PreparedStatementManager::Register(
-    const __NR_STRING_COMPAT_REF query) {
-  if (query.empty()) {
-    return std::nullopt;
+void PreparedStatementManager::Forget(StatementId id) {
+  if (!Test(prepared_, id)) {
+    return;
   }
 
-  if (nvm::strings::utility::IsWhitespaceString(
-          __NR_CALL_STRING_COMPAT_REF(query))) {
-    return std::nullopt;
+  Set(prepared_, id, false);
+  Set(stale_, id, false);
+  size_--;
+
+  auto it = lru_index_.find(id);
+  if (it != lru_index_.end()) {
+    lru_.erase(it->second);
+    lru_index_.erase(it);
   }
+}
 
-  auto key = hash_fn_(__NR_CALL_STRING_COMPAT_REF(query));
-  auto key_str = GenerateKey(key);
-  if (IsKeyExist(key_str)) {
-    
-    return std::move(std::make_pair(std::move(key_str), false));
+void PreparedStatementManager::Restore(StatementId id) {
+  if (Test(prepared_, id)) {
+    return;
   }
 
-  statements_.emplace(
-      std::string(key_str),
-      std::move(PreparedStatementItem(
-          key_str, std::to_string(key), std::string(query),
-          nvm::dates::DateTime::UtcNow().TzTime()->get_sys_time())));
-  
-  return std::move(std::make_pair(std::move(key_str), true));
+  Set(prepared_, id, true);
+  size_++;
+
+  if (capacity_ > 0 && lru_index_.find(id) == lru_index_.end()) {
+    lru_.push_back(id);
+    lru_index_.emplace(id, std::prev(lru_.end()));
+  }
 }
 
-bool PreparedStatementManager::IsKeyExist(
-    const std::string& statement_key) const {
-  return statements_.contains(statement_key);
+void PreparedStatementManager::Reset() {
+  prepared_.clear();
+  stale_.clear();
+  size_ = 0;
+  lru_.clear();
+  lru_index_.clear();
 }
 
-bool PreparedStatementManager::IsQueryExist(const std::string& query) const {
-  auto key = hash_fn_(query);
-  return PreparedStatementManager::IsKeyExist(GenerateKey(key));
+const PreparedStatementCatalogPtr& PreparedStatementManager::Catalog() const {
+  return catalog_;
+}
+
+uint32_t PreparedStatementManager::Capacity() const {
+  return capacity_;
+}
+
+size_t PreparedStatementManager::Size() const {
+  return size_;
 }
 
 PreparedStatementManagerPtr PreparedStatementManager::Share() {
   return this->shared_from_this();
 }
 
-std::string PreparedStatementManager::GenerateKey(const size_t& hash) const {
-  return "nvql_" + std::to_string(hash);
+// private:
+
+void PreparedStatementManager::Touch(StatementId id) {
+  if (capacity_ == 0) {
+    return;
+  }
+
+  auto it = lru_index_.find(id);
+  if (it != lru_index_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+
+  lru_.push_front(id);
+  lru_index_.emplace(id, lru_.begin());
+}
+
+std::optional<StatementId> PreparedStatementManager::EvictIfFull() {
+  if (capacity_ == 0 || size_ < capacity_ || lru_.empty()) {
+    return std::nullopt;
+  }
+
+  auto victim = lru_.back();
+  Forget(victim);
+  catalog_->RecordEviction(victim);
+  return victim;
+}
+
+// static
+bool PreparedStatementManager::Test(const std::vector<uint64_t>& bits,
+                                    StatementId id) {
+  auto word = id / 64;
+  return word < bits.size() && (bits[word] >> (id % 64)) & 1;
+}
+
+// static
+void PreparedStatementManager::Set(std::vector<uint64_t>& bits,
+                                   StatementId id, bool value) {
+  auto word = id / 64;
+  if (word >= bits.size()) {
+    if (!value) {
+      return;
+    }
+    bits.resize(word + 1, 0);
+  }
+
+  if (value) {
+    bits[word] |= uint64_t{1} << (id % 64);
+  } else {
+    bits[word] &= ~(uint64_t{1} << (id % 64));
+  }
 }
 
 NVSERV_END_NAMESPACE
@@ -21,67 +21,97 @@
 
 #pragma once
 
-#include <absl/container/node_hash_map.h>
+#include <absl/container/flat_hash_map.h>
 #include <nvm/dates/datetime.h>
 #include <nvm/macro.h>
 #include <nvm/strings/utility.h>
 
 #include <chrono>
 #include <functional>
+#include <list>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "nvserv/global_macro.h"
 #include "nvserv/headers/absl_thread.h"
 #include "nvserv/storages/declare.h"
+#include "nvserv/storages/prepared_statement_catalog.h"
 NVSERV_BEGIN_NAMESPACE(storages)
 
-class PreparedStatementItem {
- public:
-  explicit PreparedStatementItem(
-      const std::string& statement_key, const std::string& name,
-      const std::string& query,
-      const std::chrono::system_clock::time_point& created);
-
-  __NR_STRING_COMPAT_REF Query() const;
-
-  const std::string& Name() const;
-
-  const std::string& Key() const;
-
-  std::chrono::system_clock::time_point CreatedTime() const;
-
- private:
-  std::string statement_key_;
-  std::string name_;
-  std::string query_;
-  std::chrono::system_clock::time_point created_time_;
-};
-
 /// @brief Managing prepared statement query, one connection will be have one
-/// PreparedStatementManager.
+/// PreparedStatementManager. Statements are interned in the (pool-wide)
+/// PreparedStatementCatalog, the manager only keeps compact bitsets of ids
+/// prepared on its connection.
+/// With capacity, prepared statements are bounded per connection and the
+/// least recently used one is evicted (caller DEALLOCATE it on the server).
+/// Register records the PREPARE and the eviction up front, so statements
+/// pipelined behind it don't prepare the name twice: the caller rolls it
+/// back with Forget when PREPARE failed and Restore when DEALLOCATE failed.
+/// Not thread-safe, only used by the holder of the connection.
 class PreparedStatementManager : public std::enable_shared_from_this<
                                      PreparedStatementManager> {
  public:
-  PreparedStatementManager();
+  /// @param catalog shared catalog, own catalog is created when null
+  /// @param capacity max prepared statements, 0 is unbounded
+  explicit PreparedStatementManager(
+      PreparedStatementCatalogPtr catalog = nullptr, uint32_t capacity = 0);
   ~PreparedStatementManager();
 
-  std::optional<std::pair<std::string, bool>> Register(
+  std::optional<PreparedStatementKey> Register(
       const __NR_STRING_COMPAT_REF query);
 
-  bool IsKeyExist(const std::string& statement_key) const;
+  /// @brief Register already interned statement, no SQL lookup.
+  PreparedStatementKey Register(StatementId id);
+
+  bool IsPrepared(StatementId id) const;
 
   bool IsQueryExist(const std::string& query) const;
 
+  /// @brief Plan invalidated by the server, prepare again on next use.
+  void MarkStale(StatementId id);
+
+  /// @brief Statement no longer exists on the server.
+  void Forget(StatementId id);
+
+  /// @brief DEALLOCATE of the evicted statement failed, still prepared
+  /// on the server. Kept least recently used, evicted first again.
+  void Restore(StatementId id);
+
+  /// @brief Connection (re)opened, nothing prepared on the server.
+  void Reset();
+
+  const PreparedStatementCatalogPtr& Catalog() const;
+
+  uint32_t Capacity() const;
+
+  /// @brief Statements currently prepared on the connection.
+  size_t Size() const;
+
   PreparedStatementManagerPtr Share();
 
  private:
-  absl::node_hash_map<std::string, PreparedStatementItem> statements_;
-  std::hash<std::string> hash_fn_;
-  absl::Mutex mutex_;
+  PreparedStatementCatalogPtr catalog_;
+  std::vector<uint64_t> prepared_;
+  std::vector<uint64_t> stale_;
+  uint32_t capacity_;
+  size_t size_;
+  // Most recently used at front, only maintained with capacity
+  std::list<StatementId> lru_;
+  absl::flat_hash_map<StatementId, std::list<StatementId>::iterator>
+      lru_index_;
+
+  void Touch(StatementId id);
+
+  // Evict the least recently used statement,
+  // none when still under capacity
+  std::optional<StatementId> EvictIfFull();
+
+  static bool Test(const std::vector<uint64_t>& bits, StatementId id);
 
-  std::string GenerateKey(const size_t& hash) const;
+  static void Set(std::vector<uint64_t>& bits, StatementId id, bool value);
 };
 
 NVSERV_END_NAMESPACE
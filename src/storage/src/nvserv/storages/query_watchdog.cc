@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/query_watchdog.h"
+
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/* QueryDeadline */
+
+QueryDeadline::QueryDeadline(std::chrono::steady_clock::time_point deadline,
+                             CancelCallback cancel)
+                : deadline_(deadline),
+                  cancel_(std::move(cancel)),
+                  active_(true),
+                  expired_(false) {}
+
+const std::chrono::steady_clock::time_point& QueryDeadline::Deadline() const {
+  return deadline_;
+}
+
+bool QueryDeadline::IsExpired() const {
+  absl::MutexLock lock(&mutex_);
+  return expired_;
+}
+
+void QueryDeadline::Expire() {
+  absl::MutexLock lock(&mutex_);
+  if (!active_ || expired_) {
+    return;
+  }
+
+  expired_ = true;
+  if (cancel_) {
+    cancel_();
+  }
+}
+
+void QueryDeadline::Deactivate() {
+  absl::MutexLock lock(&mutex_);
+  active_ = false;
+}
+
+/* QueryWatchdog */
+
+QueryWatchdog::QueryWatchdog() : deadlines_() {}
+
+QueryWatchdog::~QueryWatchdog() {}
+
+QueryDeadlinePtr QueryWatchdog::Watch(std::chrono::milliseconds timeout,
+                                      QueryDeadline::CancelCallback cancel) {
+  auto deadline = std::make_shared<QueryDeadline>(
+      std::chrono::steady_clock::now() + timeout, std::move(cancel));
+
+  absl::MutexLock lock(&mutex_);
+  deadlines_.insert(deadline);
+  return deadline;
+}
+
+bool QueryWatchdog::Unwatch(const QueryDeadlinePtr& deadline) {
+  if (!deadline) {
+    return false;
+  }
+
+  {
+    absl::MutexLock lock(&mutex_);
+    deadlines_.erase(deadline);
+  }
+
+  deadline->Deactivate();
+  return deadline->IsExpired();
+}
+
+void QueryWatchdog::Check() {
+  auto now = std::chrono::steady_clock::now();
+  std::vector<QueryDeadlinePtr> expired;
+
+  {
+    absl::MutexLock lock(&mutex_);
+    for (auto it = deadlines_.begin(); it != deadlines_.end();) {
+      if ((*it)->Deadline() <= now) {
+        expired.emplace_back(*it);
+        deadlines_.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  // Cancel outside the lock, it's a network round trip
+  for (auto& deadline : expired) {
+    deadline->Expire();
+  }
+}
+
+size_t QueryWatchdog::Size() const {
+  absl::MutexLock lock(&mutex_);
+  return deadlines_.size();
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <absl/container/flat_hash_set.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "nvserv/global_macro.h"
+#include "nvserv/headers/absl_thread.h"
+
+NVSERV_BEGIN_NAMESPACE(storages)
+
+class QueryWatchdog;
+
+/// @brief Deadline of one in-flight statement registered on QueryWatchdog.
+class QueryDeadline {
+ public:
+  using CancelCallback = std::function<void()>;
+
+  QueryDeadline(std::chrono::steady_clock::time_point deadline,
+                CancelCallback cancel);
+
+  const std::chrono::steady_clock::time_point& Deadline() const;
+
+  /// @brief True when the cancel callback was fired.
+  bool IsExpired() const;
+
+ private:
+  friend class QueryWatchdog;
+
+  std::chrono::steady_clock::time_point deadline_;
+  CancelCallback cancel_;
+  bool active_;
+  bool expired_;
+  // Held while firing, Unwatch waits for it
+  mutable absl::Mutex mutex_;
+
+  // Fire the callback once when still active
+  void Expire();
+
+  // After return the callback never runs
+  void Deactivate();
+};
+
+using QueryDeadlinePtr = std::shared_ptr<QueryDeadline>;
+
+/// @brief Enforce statement deadlines from the connection pool services
+/// thread. Executing thread registers the deadline with a cancel callback
+/// before sending the statement and unregisters it once completed,
+/// watchdog periodically fires the callback of expired deadlines.
+class QueryWatchdog {
+ public:
+  QueryWatchdog();
+
+  ~QueryWatchdog();
+
+  /// @brief Register a deadline, `cancel` is called from the watchdog
+  /// thread when the deadline passed before Unwatch.
+  QueryDeadlinePtr Watch(std::chrono::milliseconds timeout,
+                         QueryDeadline::CancelCallback cancel);
+
+  /// @brief Unregister the deadline, waits for the cancel callback
+  /// when it is currently firing.
+  /// @return true when the deadline was expired (statement cancelled).
+  bool Unwatch(const QueryDeadlinePtr& deadline);
+
+  /// @brief Fire expired deadlines, called at interval.
+  void Check();
+
+  size_t Size() const;
+
+ private:
+  absl::flat_hash_set<QueryDeadlinePtr> deadlines_;
+  mutable absl::Mutex mutex_;
+};
+
+using QueryWatchdogPtr = std::shared_ptr<QueryWatchdog>;
+
+NVSERV_END_NAMESPACE
@@ -35,10 +35,37 @@ std::optional<Column> RowResult::GetColumn(const int& index) const {
   return std::nullopt;
 }
 
+std::string_view RowResult::AsStringView(const int& index) const {
+  return AsImpl_string_view(index);
+}
+
+std::string_view RowResult::AsStringView(
+    const std::string& column_name) const {
+  return AsImpl_string_view(ColumnIndexOrThrow(column_name));
+}
+
+BytesView RowResult::AsBytes(const int& index) const {
+  return AsImpl_bytes(index);
+}
+
+BytesView RowResult::AsBytes(const std::string& column_name) const {
+  return AsImpl_bytes(ColumnIndexOrThrow(column_name));
+}
+
 size_t RowResult::Size() const {
   throw std::runtime_error("Implement RowResult::Size() on derrived class");
 }
 
+// private:
+
+int RowResult::ColumnIndexOrThrow(const std::string& column_name) const {
+  auto index = FindColumnIndex(column_name);
+  if (index < 0) {
+    throw std::invalid_argument("Unknown column [" + column_name + "]");
+  }
+  return index;
+}
+
 // ColumnIterator RowResult::begin() const {
 //     return ColumnIterator(row_, 0);
 // }
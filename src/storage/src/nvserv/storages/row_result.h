@@ -24,12 +24,15 @@
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
 #include "nvm/dates/datetime.h"
 #include "nvm/macro.h"
 #include "nvserv/global_macro.h"
+#include "nvserv/storages/bytes_view.h"
 #include "nvserv/storages/column.h"
 #include "nvserv/storages/declare.h"
 
@@ -40,6 +43,14 @@ NVSERV_BEGIN_NAMESPACE(storages)
 template <typename T, typename TType>
 constexpr bool is_type_v = std::is_same_v<T, TType>;
 
+/// @brief Outcome of the non-throwing TryAs<T> accessors.
+enum class FieldStatus {
+  Ok,
+  Null,
+  UnknownColumn,
+  Invalid
+};
+
 class RowResult {
  public:
   virtual std::optional<Column> GetColumn(const std::string& column_name) const;
@@ -52,6 +63,35 @@ class RowResult {
   template <typename T>
   T As(const std::string& column_name) const;
 
+  /// @brief Non-throwing As<T>, nullopt on null, unknown column or value
+  /// that can't be converted; the reason is written to status when given.
+  template <typename T>
+  std::optional<T> TryAs(const int& index,
+                         FieldStatus* status = nullptr) const;
+
+  template <typename T>
+  std::optional<T> TryAs(const std::string& column_name,
+                         FieldStatus* status = nullptr) const;
+
+  /// @brief Text field as view into the result buffer, no copy.
+  /// Valid as long as the row or its ExecutionResult is alive,
+  /// throws std::invalid_argument on null or binary non-text column.
+  std::string_view AsStringView(const int& index) const;
+
+  std::string_view AsStringView(const std::string& column_name) const;
+
+  /// @brief Raw field bytes as view into the result buffer, no copy.
+  /// Bytea is only available raw in binary format,
+  /// throws std::invalid_argument on null or text-format bytea.
+  BytesView AsBytes(const int& index) const;
+
+  BytesView AsBytes(const std::string& column_name) const;
+
+  /// @brief Field is null, throws std::invalid_argument on unknown column.
+  virtual bool IsNull(const int& index) const = 0;
+
+  virtual bool IsNull(const std::string& column_name) const = 0;
+
   template <typename T>
   T AsDateTimeOffset(const int& index);
 
@@ -92,6 +132,39 @@ class RowResult {
       const std::string& column_name) const = 0;
   virtual nvm::dates::DateTime AsImpl_DateTime_Timestamp(
       const int& index) const = 0;
+
+  virtual std::string_view AsImpl_string_view(const int& index) const = 0;
+  virtual BytesView AsImpl_bytes(const int& index) const = 0;
+
+  virtual std::vector<int16_t> AsImpl_vector_int16_t(
+      const int& index) const = 0;
+  virtual std::vector<int32_t> AsImpl_vector_int32_t(
+      const int& index) const = 0;
+  virtual std::vector<int64_t> AsImpl_vector_int64_t(
+      const int& index) const = 0;
+  virtual std::vector<float> AsImpl_vector_float(const int& index) const = 0;
+  virtual std::vector<double> AsImpl_vector_double(const int& index) const = 0;
+  virtual std::vector<std::string> AsImpl_vector_string(
+      const int& index) const = 0;
+
+  /// @brief Column index by name, -1 when the column is not exist.
+  virtual int FindColumnIndex(const std::string& column_name) const = 0;
+
+  virtual FieldStatus TryAsImpl_int16_t(const int& index,
+                                        int16_t& value) const = 0;
+  virtual FieldStatus TryAsImpl_int32_t(const int& index,
+                                        int32_t& value) const = 0;
+  virtual FieldStatus TryAsImpl_int64_t(const int& index,
+                                        int64_t& value) const = 0;
+  virtual FieldStatus TryAsImpl_string(const int& index,
+                                       std::string& value) const = 0;
+  virtual FieldStatus TryAsImpl_float(const int& index,
+                                      float& value) const = 0;
+  virtual FieldStatus TryAsImpl_double(const int& index,
+                                       double& value) const = 0;
+
+ private:
+  int ColumnIndexOrThrow(const std::string& column_name) const;
 };
 
 template <typename T>
@@ -108,6 +181,18 @@ T RowResult::As(const int& index) const {
     return AsImpl_double(index);
   } else if constexpr (is_type_v<T, std::string>) {
     return AsImpl_string(index);
+  } else if constexpr (is_type_v<T, std::vector<int16_t>>) {
+    return AsImpl_vector_int16_t(index);
+  } else if constexpr (is_type_v<T, std::vector<int32_t>>) {
+    return AsImpl_vector_int32_t(index);
+  } else if constexpr (is_type_v<T, std::vector<int64_t>>) {
+    return AsImpl_vector_int64_t(index);
+  } else if constexpr (is_type_v<T, std::vector<float>>) {
+    return AsImpl_vector_float(index);
+  } else if constexpr (is_type_v<T, std::vector<double>>) {
+    return AsImpl_vector_double(index);
+  } else if constexpr (is_type_v<T, std::vector<std::string>>) {
+    return AsImpl_vector_string(index);
   } else {
     static_assert("RowResult.As<T>, T is not supported by NvQL");
   }
@@ -129,6 +214,18 @@ T RowResult::As(const std::string& column_name) const {
     return AsImpl_double(column_name);
   } else if constexpr (is_type_v<T, std::string>) {
     return AsImpl_string(column_name);
+  } else if constexpr (is_type_v<T, std::vector<int16_t>>) {
+    return AsImpl_vector_int16_t(ColumnIndexOrThrow(column_name));
+  } else if constexpr (is_type_v<T, std::vector<int32_t>>) {
+    return AsImpl_vector_int32_t(ColumnIndexOrThrow(column_name));
+  } else if constexpr (is_type_v<T, std::vector<int64_t>>) {
+    return AsImpl_vector_int64_t(ColumnIndexOrThrow(column_name));
+  } else if constexpr (is_type_v<T, std::vector<float>>) {
+    return AsImpl_vector_float(ColumnIndexOrThrow(column_name));
+  } else if constexpr (is_type_v<T, std::vector<double>>) {
+    return AsImpl_vector_double(ColumnIndexOrThrow(column_name));
+  } else if constexpr (is_type_v<T, std::vector<std::string>>) {
+    return AsImpl_vector_string(ColumnIndexOrThrow(column_name));
   } else {
     static_assert(is_type_v<T, int64_t>,
                   "RowResult.As<T>, T is not supported by NvQL");
@@ -137,6 +234,50 @@ T RowResult::As(const std::string& column_name) const {
   throw std::invalid_argument("RowResult.As<T>, T is not supported by NvQL");
 }
 
+template <typename T>
+std::optional<T> RowResult::TryAs(const int& index,
+                                  FieldStatus* status) const {
+  T value{};
+  FieldStatus result;
+  if constexpr (is_type_v<T, int64_t>) {
+    result = TryAsImpl_int64_t(index, value);
+  } else if constexpr (is_type_v<T, int32_t>) {
+    result = TryAsImpl_int32_t(index, value);
+  } else if constexpr (is_type_v<T, int16_t>) {
+    result = TryAsImpl_int16_t(index, value);
+  } else if constexpr (is_type_v<T, float>) {
+    result = TryAsImpl_float(index, value);
+  } else if constexpr (is_type_v<T, double>) {
+    result = TryAsImpl_double(index, value);
+  } else if constexpr (is_type_v<T, std::string>) {
+    result = TryAsImpl_string(index, value);
+  } else {
+    static_assert(is_type_v<T, int64_t>,
+                  "RowResult.TryAs<T>, T is not supported by NvQL");
+  }
+
+  if (status) {
+    *status = result;
+  }
+  if (result != FieldStatus::Ok) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+template <typename T>
+std::optional<T> RowResult::TryAs(const std::string& column_name,
+                                  FieldStatus* status) const {
+  auto index = FindColumnIndex(column_name);
+  if (index < 0) {
+    if (status) {
+      *status = FieldStatus::UnknownColumn;
+    }
+    return std::nullopt;
+  }
+  return TryAs<T>(index, status);
+}
+
 template <typename T>
 T RowResult::AsDateTimeOffset(const int& index) {
   if constexpr (is_type_v<T, nvm::dates::DateTime>) {
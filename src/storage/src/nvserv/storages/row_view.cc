@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/row_view.h"
+
+#include "nvserv/storages/execution_result.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/* RowView */
+
+RowView::RowView(const ExecutionResult& result, int row)
+                : result_(&result), row_(row) {}
+
+size_t RowView::Size() const {
+  return static_cast<size_t>(result_->ColumnCount());
+}
+
+int RowView::Index() const {
+  return row_;
+}
+
+bool RowView::IsNull(const int& index) const {
+  return result_->IsNull(row_, index);
+}
+
+bool RowView::IsNull(const std::string& column_name) const {
+  return result_->IsNull(row_, ColumnIndex(column_name));
+}
+
+std::string_view RowView::AsStringView(const int& index) const {
+  return result_->AsImpl_string_view(row_, index);
+}
+
+std::string_view RowView::AsStringView(const std::string& column_name) const {
+  return result_->AsImpl_string_view(row_, ColumnIndex(column_name));
+}
+
+BytesView RowView::AsBytes(const int& index) const {
+  return result_->AsImpl_bytes(row_, index);
+}
+
+BytesView RowView::AsBytes(const std::string& column_name) const {
+  return result_->AsImpl_bytes(row_, ColumnIndex(column_name));
+}
+
+// private:
+
+int RowView::ColumnIndex(const std::string& column_name) const {
+  return result_->ColumnIndex(column_name);
+}
+
+int16_t RowView::AsImpl_int16_t(const int& index) const {
+  return result_->AsImpl_int16_t(row_, index);
+}
+
+int32_t RowView::AsImpl_int32_t(const int& index) const {
+  return result_->AsImpl_int32_t(row_, index);
+}
+
+int64_t RowView::AsImpl_int64_t(const int& index) const {
+  return result_->AsImpl_int64_t(row_, index);
+}
+
+std::string RowView::AsImpl_string(const int& index) const {
+  return result_->AsImpl_string(row_, index);
+}
+
+float RowView::AsImpl_float(const int& index) const {
+  return result_->AsImpl_float(row_, index);
+}
+
+double RowView::AsImpl_double(const int& index) const {
+  return result_->AsImpl_double(row_, index);
+}
+
+nvm::dates::DateTime RowView::AsImpl_DateTime_Timestampz(
+    const int& index) const {
+  return result_->AsImpl_DateTime_Timestampz(row_, index);
+}
+
+nvm::dates::DateTime RowView::AsImpl_DateTime_Timestamp(
+    const int& index) const {
+  return result_->AsImpl_DateTime_Timestamp(row_, index);
+}
+
+std::vector<int16_t> RowView::AsImpl_vector_int16_t(const int& index) const {
+  return result_->AsImpl_vector_int16_t(row_, index);
+}
+
+std::vector<int32_t> RowView::AsImpl_vector_int32_t(const int& index) const {
+  return result_->AsImpl_vector_int32_t(row_, index);
+}
+
+std::vector<int64_t> RowView::AsImpl_vector_int64_t(const int& index) const {
+  return result_->AsImpl_vector_int64_t(row_, index);
+}
+
+std::vector<float> RowView::AsImpl_vector_float(const int& index) const {
+  return result_->AsImpl_vector_float(row_, index);
+}
+
+std::vector<double> RowView::AsImpl_vector_double(const int& index) const {
+  return result_->AsImpl_vector_double(row_, index);
+}
+
+std::vector<std::string> RowView::AsImpl_vector_string(const int& index) const {
+  return result_->AsImpl_vector_string(row_, index);
+}
+
+int RowView::FindColumnIndex(const std::string& column_name) const {
+  return result_->FindColumnIndex(column_name);
+}
+
+FieldStatus RowView::TryAsImpl_int16_t(const int& index,
+                                       int16_t& value) const {
+  return result_->TryAsImpl_int16_t(row_, index, value);
+}
+
+FieldStatus RowView::TryAsImpl_int32_t(const int& index,
+                                       int32_t& value) const {
+  return result_->TryAsImpl_int32_t(row_, index, value);
+}
+
+FieldStatus RowView::TryAsImpl_int64_t(const int& index,
+                                       int64_t& value) const {
+  return result_->TryAsImpl_int64_t(row_, index, value);
+}
+
+FieldStatus RowView::TryAsImpl_string(const int& index,
+                                      std::string& value) const {
+  return result_->TryAsImpl_string(row_, index, value);
+}
+
+FieldStatus RowView::TryAsImpl_float(const int& index, float& value) const {
+  return result_->TryAsImpl_float(row_, index, value);
+}
+
+FieldStatus RowView::TryAsImpl_double(const int& index, double& value) const {
+  return result_->TryAsImpl_double(row_, index, value);
+}
+
+/* RowViewRange */
+
+RowViewRange::RowViewRange(const ExecutionResult& result) : result_(result) {}
+
+RowViewRange::Iterator RowViewRange::begin() const {
+  return Iterator(result_, 0);
+}
+
+RowViewRange::Iterator RowViewRange::end() const {
+  return Iterator(result_, result_.RowCount());
+}
+
+int RowViewRange::Size() const {
+  return result_.RowCount();
+}
+
+NVSERV_END_NAMESPACE
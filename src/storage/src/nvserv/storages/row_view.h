@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nvm/dates/datetime.h"
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/bytes_view.h"
+#include "nvserv/storages/declare.h"
+#include "nvserv/storages/row_result.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/// @brief Lightweight row of ExecutionResult referenced by index.
+/// Same As<T> API as RowResult without allocating per row,
+/// valid as long as the ExecutionResult is alive.
+class RowView {
+ public:
+  explicit RowView(const ExecutionResult& result, int row);
+
+  template <typename T>
+  T As(const int& index) const;
+
+  template <typename T>
+  T As(const std::string& column_name) const;
+
+  /// @brief Non-throwing As<T>, see RowResult::TryAs.
+  template <typename T>
+  std::optional<T> TryAs(const int& index,
+                         FieldStatus* status = nullptr) const;
+
+  template <typename T>
+  std::optional<T> TryAs(const std::string& column_name,
+                         FieldStatus* status = nullptr) const;
+
+  bool IsNull(const int& index) const;
+
+  bool IsNull(const std::string& column_name) const;
+
+  /// @brief Text field as view into the result buffer,
+  /// see RowResult::AsStringView.
+  std::string_view AsStringView(const int& index) const;
+
+  std::string_view AsStringView(const std::string& column_name) const;
+
+  /// @brief Raw field bytes as view into the result buffer,
+  /// see RowResult::AsBytes.
+  BytesView AsBytes(const int& index) const;
+
+  BytesView AsBytes(const std::string& column_name) const;
+
+  template <typename T>
+  T AsDateTimeOffset(const int& index) const;
+
+  template <typename T>
+  T AsDateTimeOffset(const std::string& column_name) const;
+
+  template <typename T>
+  T AsDateTime(const int& index) const;
+
+  template <typename T>
+  T AsDateTime(const std::string& column_name) const;
+
+  size_t Size() const;
+
+  /// @brief Row offset in the result.
+  int Index() const;
+
+ private:
+  const ExecutionResult* result_;
+  int row_;
+
+  int ColumnIndex(const std::string& column_name) const;
+
+  int16_t AsImpl_int16_t(const int& index) const;
+  int32_t AsImpl_int32_t(const int& index) const;
+  int64_t AsImpl_int64_t(const int& index) const;
+  std::string AsImpl_string(const int& index) const;
+  float AsImpl_float(const int& index) const;
+  double AsImpl_double(const int& index) const;
+  nvm::dates::DateTime AsImpl_DateTime_Timestampz(const int& index) const;
+  nvm::dates::DateTime AsImpl_DateTime_Timestamp(const int& index) const;
+  std::vector<int16_t> AsImpl_vector_int16_t(const int& index) const;
+  std::vector<int32_t> AsImpl_vector_int32_t(const int& index) const;
+  std::vector<int64_t> AsImpl_vector_int64_t(const int& index) const;
+  std::vector<float> AsImpl_vector_float(const int& index) const;
+  std::vector<double> AsImpl_vector_double(const int& index) const;
+  std::vector<std::string> AsImpl_vector_string(const int& index) const;
+
+  int FindColumnIndex(const std::string& column_name) const;
+
+  FieldStatus TryAsImpl_int16_t(const int& index, int16_t& value) const;
+  FieldStatus TryAsImpl_int32_t(const int& index, int32_t& value) const;
+  FieldStatus TryAsImpl_int64_t(const int& index, int64_t& value) const;
+  FieldStatus TryAsImpl_string(const int& index, std::string& value) const;
+  FieldStatus TryAsImpl_float(const int& index, float& value) const;
+  FieldStatus TryAsImpl_double(const int& index, double& value) const;
+};
+
+/// @brief Rows of ExecutionResult as RowView, for range-for iteration
+/// without per-row allocation.
+///
+/// Stepping and comparing only touch the row offset and are defined inline.
+/// Dereferencing yields RowView by value (a proxy), which a legacy forward
+/// iterator may not do, so iterator_category is input while
+/// iterator_concept is random-access: C++20 `std::ranges` algorithms and
+/// views (`std::ranges::lower_bound`, `std::views::drop`, ...) jump over
+/// the rows directly, pre-C++20 algorithms treat the range as single pass.
+/// The rows themselves can't be permuted in place, sort projections such
+/// as row offsets instead.
+class RowViewRange {
+ public:
+  explicit RowViewRange(const ExecutionResult& result);
+
+  class Iterator {
+   public:
+    // operator* returns by value, see the class comment
+    using iterator_category = std::input_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = std::random_access_iterator_tag;
+#endif
+    using value_type = RowView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = RowView;
+
+    Iterator();
+
+    explicit Iterator(const ExecutionResult& result, int row);
+
+    Iterator& operator++();
+
+    Iterator operator++(int);
+
+    Iterator& operator--();
+
+    Iterator operator--(int);
+
+    Iterator& operator+=(difference_type n);
+
+    Iterator& operator-=(difference_type n);
+
+    Iterator operator+(difference_type n) const;
+
+    Iterator operator-(difference_type n) const;
+
+    difference_type operator-(const Iterator& other) const;
+
+    friend Iterator operator+(difference_type n, const Iterator& iter) {
+      return iter + n;
+    }
+
+    bool operator==(const Iterator& other) const;
+
+    bool operator!=(const Iterator& other) const;
+
+    bool operator<(const Iterator& other) const;
+
+    bool operator>(const Iterator& other) const;
+
+    bool operator<=(const Iterator& other) const;
+
+    bool operator>=(const Iterator& other) const;
+
+    RowView operator*() const;
+
+    RowView operator[](difference_type n) const;
+
+   private:
+    const ExecutionResult* result_;
+    int row_;
+  };
+
+  Iterator begin() const;
+
+  Iterator end() const;
+
+  int Size() const;
+
+ private:
+  const ExecutionResult& result_;
+};
+
+/* RowViewRange::Iterator */
+
+inline RowViewRange::Iterator::Iterator() : result_(nullptr), row_(0) {}
+
+inline RowViewRange::Iterator::Iterator(const ExecutionResult& result,
+                                        int row)
+                : result_(&result), row_(row) {}
+
+inline RowViewRange::Iterator& RowViewRange::Iterator::operator++() {
+  ++row_;
+  return *this;
+}
+
+inline RowViewRange::Iterator RowViewRange::Iterator::operator++(int) {
+  auto copy = *this;
+  ++row_;
+  return copy;
+}
+
+inline RowViewRange::Iterator& RowViewRange::Iterator::operator--() {
+  --row_;
+  return *this;
+}
+
+inline RowViewRange::Iterator RowViewRange::Iterator::operator--(int) {
+  auto copy = *this;
+  --row_;
+  return copy;
+}
+
+inline RowViewRange::Iterator& RowViewRange::Iterator::operator+=(
+    difference_type n) {
+  row_ += static_cast<int>(n);
+  return *this;
+}
+
+inline RowViewRange::Iterator& RowViewRange::Iterator::operator-=(
+    difference_type n) {
+  row_ -= static_cast<int>(n);
+  return *this;
+}
+
+inline RowViewRange::Iterator RowViewRange::Iterator::operator+(
+    difference_type n) const {
+  auto copy = *this;
+  copy += n;
+  return copy;
+}
+
+inline RowViewRange::Iterator RowViewRange::Iterator::operator-(
+    difference_type n) const {
+  auto copy = *this;
+  copy -= n;
+  return copy;
+}
+
+inline RowViewRange::Iterator::difference_type
+RowViewRange::Iterator::operator-(const Iterator& other) const {
+  return static_cast<difference_type>(row_) - other.row_;
+}
+
+inline bool RowViewRange::Iterator::operator==(const Iterator& other) const {
+  return result_ == other.result_ && row_ == other.row_;
+}
+
+inline bool RowViewRange::Iterator::operator!=(const Iterator& other) const {
+  return !(*this == other);
+}
+
+inline bool RowViewRange::Iterator::operator<(const Iterator& other) const {
+  return row_ < other.row_;
+}
+
+inline bool RowViewRange::Iterator::operator>(const Iterator& other) const {
+  return other < *this;
+}
+
+inline bool RowViewRange::Iterator::operator<=(const Iterator& other) const {
+  return !(other < *this);
+}
+
+inline bool RowViewRange::Iterator::operator>=(const Iterator& other) const {
+  return !(*this < other);
+}
+
+inline RowView RowViewRange::Iterator::operator*() const {
+  return RowView(*result_, row_);
+}
+
+inline RowView RowViewRange::Iterator::operator[](difference_type n) const {
+  return RowView(*result_, row_ + static_cast<int>(n));
+}
+
+#if !NVQL_SINGLE_DRIVER
+/// @brief Multi-driver build, typed rows stay polymorphic.
+/// Single-driver builds alias these to the driver views,
+/// see postgres/pg_row_view.h.
+using NativeRowView = RowView;
+using NativeRowRange = RowViewRange;
+#endif
+
+template <typename T>
+T RowView::As(const int& index) const {
+  if constexpr (is_type_v<T, int64_t>) {
+    return AsImpl_int64_t(index);
+  } else if constexpr (is_type_v<T, int32_t>) {
+    return AsImpl_int32_t(index);
+  } else if constexpr (is_type_v<T, int16_t>) {
+    return AsImpl_int16_t(index);
+  } else if constexpr (is_type_v<T, float>) {
+    return AsImpl_float(index);
+  } else if constexpr (is_type_v<T, double>) {
+    return AsImpl_double(index);
+  } else if constexpr (is_type_v<T, std::string>) {
+    return AsImpl_string(index);
+  } else if constexpr (is_type_v<T, std::vector<int16_t>>) {
+    return AsImpl_vector_int16_t(index);
+  } else if constexpr (is_type_v<T, std::vector<int32_t>>) {
+    return AsImpl_vector_int32_t(index);
+  } else if constexpr (is_type_v<T, std::vector<int64_t>>) {
+    return AsImpl_vector_int64_t(index);
+  } else if constexpr (is_type_v<T, std::vector<float>>) {
+    return AsImpl_vector_float(index);
+  } else if constexpr (is_type_v<T, std::vector<double>>) {
+    return AsImpl_vector_double(index);
+  } else if constexpr (is_type_v<T, std::vector<std::string>>) {
+    return AsImpl_vector_string(index);
+  } else {
+    static_assert(is_type_v<T, int64_t>,
+                  "RowView.As<T>, T is not supported by NvQL");
+  }
+}
+
+template <typename T>
+T RowView::As(const std::string& column_name) const {
+  return As<T>(ColumnIndex(column_name));
+}
+
+template <typename T>
+std::optional<T> RowView::TryAs(const int& index, FieldStatus* status) const {
+  T value{};
+  FieldStatus result;
+  if constexpr (is_type_v<T, int64_t>) {
+    result = TryAsImpl_int64_t(index, value);
+  } else if constexpr (is_type_v<T, int32_t>) {
+    result = TryAsImpl_int32_t(index, value);
+  } else if constexpr (is_type_v<T, int16_t>) {
+    result = TryAsImpl_int16_t(index, value);
+  } else if constexpr (is_type_v<T, float>) {
+    result = TryAsImpl_float(index, value);
+  } else if constexpr (is_type_v<T, double>) {
+    result = TryAsImpl_double(index, value);
+  } else if constexpr (is_type_v<T, std::string>) {
+    result = TryAsImpl_string(index, value);
+  } else {
+    static_assert(is_type_v<T, int64_t>,
+                  "RowView.TryAs<T>, T is not supported by NvQL");
+  }
+
+  if (status) {
+    *status = result;
+  }
+  if (result != FieldStatus::Ok) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+template <typename T>
+std::optional<T> RowView::TryAs(const std::string& column_name,
+                                FieldStatus* status) const {
+  auto index = FindColumnIndex(column_name);
+  if (index < 0) {
+    if (status) {
+      *status = FieldStatus::UnknownColumn;
+    }
+    return std::nullopt;
+  }
+  return TryAs<T>(index, status);
+}
+
+template <typename T>
+T RowView::AsDateTimeOffset(const int& index) const {
+  if constexpr (is_type_v<T, nvm::dates::DateTime>) {
+    return AsImpl_DateTime_Timestampz(index);
+  } else {
+    static_assert(is_type_v<T, int64_t>,
+                  "RowView.AsDateTimeOffset<T>, T is not supported by NvQL");
+  }
+}
+
+template <typename T>
+T RowView::AsDateTimeOffset(const std::string& column_name) const {
+  return AsDateTimeOffset<T>(ColumnIndex(column_name));
+}
+
+template <typename T>
+T RowView::AsDateTime(const int& index) const {
+  if constexpr (is_type_v<T, nvm::dates::DateTime>) {
+    return AsImpl_DateTime_Timestamp(index);
+  } else {
+    static_assert(is_type_v<T, int64_t>,
+                  "RowView.AsDateTime<T>, T is not supported by NvQL");
+  }
+}
+
+template <typename T>
+T RowView::AsDateTime(const std::string& column_name) const {
+  return AsDateTime<T>(ColumnIndex(column_name));
+}
+
+NVSERV_END_NAMESPACE
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/statement_handle.h"
+
+// cppcheck-suppress unknownMacro
+NVSERV_BEGIN_NAMESPACE(storages)
+
+StatementHandle::StatementHandle()
+                : catalog_(nullptr),
+                  id_(0),
+                  name_(nullptr),
+                  query_(nullptr),
+                  param_types_() {}
+
+StatementHandle::StatementHandle(const PreparedStatementCatalog* catalog,
+                                 StatementId id,
+                                 std::vector<uint32_t> param_types)
+                : catalog_(catalog),
+                  id_(id),
+                  name_(&catalog->Name(id)),
+                  query_(&catalog->Query(id)),
+                  param_types_(std::move(param_types)) {}
+
+bool StatementHandle::IsValid() const {
+  return catalog_ != nullptr;
+}
+
+StatementId StatementHandle::Id() const {
+  return id_;
+}
+
+const std::string& StatementHandle::Name() const {
+  return *name_;
+}
+
+const std::string& StatementHandle::Query() const {
+  return *query_;
+}
+
+const std::vector<uint32_t>& StatementHandle::ParamTypes() const {
+  return param_types_;
+}
+
+const PreparedStatementCatalog* StatementHandle::Catalog() const {
+  return catalog_;
+}
+
+NVSERV_END_NAMESPACE
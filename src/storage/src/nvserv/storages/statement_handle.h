@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nvserv/global_macro.h"
+#include "nvserv/storages/declare.h"
+#include "nvserv/storages/prepared_statement_catalog.h"
+
+NVSERV_BEGIN_NAMESPACE(storages)
+
+/// @brief Statement interned up-front with `StorageServer::Prepare`.
+/// Executing through the handle skips the SQL text lookup entirely,
+/// connection only checks its prepared bitset by id.
+/// Cheap to copy, only valid for the server that created it.
+class StatementHandle {
+ public:
+  /// @brief Invalid handle
+  StatementHandle();
+
+  StatementHandle(const PreparedStatementCatalog* catalog, StatementId id,
+                  std::vector<uint32_t> param_types);
+
+  bool IsValid() const;
+
+  StatementId Id() const;
+
+  /// @brief Server side prepared statement name.
+  const std::string& Name() const;
+
+  const std::string& Query() const;
+
+  /// @brief Storage specific parameter type ids (postgres: OID),
+  /// empty lets the server infer them.
+  const std::vector<uint32_t>& ParamTypes() const;
+
+  /// @brief Catalog the statement was interned in.
+  const PreparedStatementCatalog* Catalog() const;
+
+ private:
+  const PreparedStatementCatalog* catalog_;
+  StatementId id_;
+  const std::string* name_;
+  const std::string* query_;
+  std::vector<uint32_t> param_types_;
+};
+
+NVSERV_END_NAMESPACE
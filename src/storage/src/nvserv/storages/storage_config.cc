@@ -81,4 +81,8 @@ const ConnectionPoolConfig& StorageConfig::PoolConfig() const {
   return pool_config_;
 }
 
+const nvm::threads::TaskPoolPtr& StorageConfig::TaskPool() const {
+  return task_pool_;
+}
+
 NVSERV_END_NAMESPACE
\ No newline at end of file
@@ -54,6 +54,7 @@ class StorageConfigBase {
   virtual const ClusterConfigList& ClusterConfigs() const = 0;
   virtual const ConnectionMode& ConnectionModeOption() const = 0;
   virtual const ConnectionPoolConfig& PoolConfig() const = 0;
+  virtual const nvm::threads::TaskPoolPtr& TaskPool() const = 0;
 
  protected:
   StorageConfigBase();
@@ -79,6 +80,10 @@ class StorageConfig : public StorageConfigBase {
 
   const ConnectionPoolConfig& PoolConfig() const override;
 
+  /// @brief TaskPool supplied by the caller, null when NvQL should create
+  /// its own pool (TaskPoolMode::Internal) or when async is disabled.
+  const nvm::threads::TaskPoolPtr& TaskPool() const override;
+
  protected:
   explicit StorageConfig(StorageType type, TransactionMode transact_mode,
                          bool pool_support, ConnectionPoolConfig&& pool_config,
@@ -21,7 +21,9 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <future>
 #include <ostream>
 
 #if not defined(NVQL_STANDALONE) || NVQL_STANDALONE == 0
@@ -29,9 +31,13 @@
 #endif
 
 #include "nvserv/global_macro.h"
+#include "nvserv/storages/async_execution.h"
 #include "nvserv/storages/cluster_config.h"
 #include "nvserv/storages/connection_pool.h"
 #include "nvserv/storages/declare.h"
+#include "nvserv/storages/parameters/param.h"
+#include "nvserv/storages/parameters/param_pack.h"
+#include "nvserv/storages/transaction.h"
 
 NVSERV_BEGIN_NAMESPACE(storages)
 
@@ -68,6 +74,64 @@ class StorageServer : public components::Component {
 
     virtual TransactionPtr Begin(TransactionMode mode) = 0;
 
+    /// @brief Begin with a deadline for each statement of the transaction,
+    /// see Transaction::SetStatementTimeout.
+    TransactionPtr Begin(TransactionMode mode,
+                         std::chrono::milliseconds statement_timeout,
+                         bool server_side = false) {
+      auto tx = Begin(mode);
+      tx->SetStatementTimeout(statement_timeout, server_side);
+      return tx;
+    }
+
+    /// @brief Begin the transaction on the storage TaskPool,
+    /// acquiring connection from the pool won't block the caller thread.
+    virtual std::future<TransactionPtr> BeginAsync(TransactionMode mode) = 0;
+
+    /// @brief Execute a lone statement in TransactionMode::AutoCommit,
+    /// no BEGIN/COMMIT round trips, the connection is returned to the pool
+    /// before the result is returned. Uses prepared statement.
+    /// The parameters are only read during the call.
+    virtual ExecutionResultPtr Execute(const __NR_STRING_COMPAT_REF query,
+                                       const parameters::ParamView& args) = 0;
+
+    ExecutionResultPtr Execute(const __NR_STRING_COMPAT_REF query,
+                               const parameters::ParameterArgs& args) {
+      return Execute(query, parameters::ParamView(args));
+    }
+
+    /// @brief Intern the statement once, execute it later with
+    /// `Transaction::Execute(const StatementHandle&, ...)`.
+    /// @param types parameter types, empty lets the server infer them
+    virtual StatementHandle Prepare(
+        const __NR_STRING_COMPAT_REF query,
+        const std::vector<parameters::DataType>& types) = 0;
+
+    StatementHandle Prepare(const __NR_STRING_COMPAT_REF query) {
+      return Prepare(query, std::vector<parameters::DataType>());
+    }
+
+    template <typename... Args>
+    ExecutionResultPtr Execute(const __NR_STRING_COMPAT_REF query,
+                               const Args&... args) {
+      // Params reference the arguments, alive for the whole call
+      std::array<parameters::Param, sizeof...(Args)> params = {
+          {parameters::impl::ToParam(args)...}};
+      return Execute(query, parameters::ParamView(params));
+    }
+
+#if __cplusplus >= 202002L
+    /// @brief co_await-able variant of Begin
+    Awaitable<TransactionPtr> BeginAwaitable(TransactionMode mode) {
+      return Awaitable<TransactionPtr>(TaskPool(), Configs().Type(),
+                                       [this, mode]() { return Begin(mode); });
+    }
+#endif
+
+    /// @brief TaskPool used for async executions,
+    /// null when async execution is disabled.
+    virtual const nvm::threads::TaskPoolPtr& TaskPool() const = 0;
+
     virtual  ConnectionPoolPtr Pool() const = 0;
 
     virtual ConnectionPoolPtr Pool() = 0;
@@ -24,29 +24,145 @@
 // cppcheck-suppress unknownMacro
 NVSERV_BEGIN_NAMESPACE(storages)
 
-Transaction::Transaction(StorageType type, TransactionMode mode)
-                : type_(type), mode_(mode){};
+Transaction::Transaction(StorageType type, TransactionMode mode,
+                         nvm::threads::TaskPoolPtr task_pool)
+                : type_(type),
+                  mode_(mode),
+                  task_pool_(std::move(task_pool)),
+                  statement_timeout_(std::chrono::milliseconds::zero()),
+                  server_side_timeout_(false){};
 
 Transaction::~Transaction(){};
 
 [[nodiscard]] ExecutionResultPtr Transaction::Execute(
     const __NR_STRING_COMPAT_REF query) {
-  return ExecuteImpl(query, parameters::ParameterArgs());
+  return ExecuteSync(query, parameters::ParamView(), true);
 }
 
 [[nodiscard]] ExecutionResultPtr Transaction::Execute(
     const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
-  return ExecuteImpl(query, args);
+  return ExecuteSync(query, args, true);
 }
 
 [[nodiscard]] ExecutionResultPtr Transaction::ExecuteNonPrepared(
     const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
-  return ExecuteNonPreparedImpl(query, args);
+  return ExecuteSync(query, args, false);
+}
+
+[[nodiscard]] ExecutionResultPtr Transaction::Execute(
+    const StatementHandle& statement, const parameters::ParameterArgs& args) {
+  return ExecuteStatement(statement, args);
 }
 
 [[nodiscard]] ExecutionResultPtr Transaction::ExecuteNonPrepared(
     const __NR_STRING_COMPAT_REF query) {
-  return ExecuteNonPreparedImpl(query, parameters::ParameterArgs());
+  return ExecuteSync(query, parameters::ParamView(), false);
+}
+
+[[nodiscard]] ExecutionResultPtr Transaction::Execute(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args,
+    std::chrono::milliseconds timeout) {
+  absl::MutexLock lock(&async_mutex_);
+  auto previous = std::exchange(statement_timeout_, timeout);
+  try {
+    auto result = ExecuteImpl(query, args);
+    statement_timeout_ = previous;
+    return __NR_RETURN_MOVE(result);
+  } catch (...) {
+    statement_timeout_ = previous;
+    throw;
+  }
+}
+
+[[nodiscard]] ExecutionResultPtr Transaction::ExecuteNonPrepared(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args,
+    std::chrono::milliseconds timeout) {
+  absl::MutexLock lock(&async_mutex_);
+  auto previous = std::exchange(statement_timeout_, timeout);
+  try {
+    auto result = ExecuteNonPreparedImpl(query, args);
+    statement_timeout_ = previous;
+    return __NR_RETURN_MOVE(result);
+  } catch (...) {
+    statement_timeout_ = previous;
+    throw;
+  }
+}
+
+[[nodiscard]] std::future<ExecutionResultPtr> Transaction::ExecuteAsync(
+    const __NR_STRING_COMPAT_REF query) {
+  return ExecuteAsyncImpl(__NR_CALL_STRING_COMPAT_REF(query),
+                          parameters::ParameterArgs(), true, nullptr);
+}
+
+[[nodiscard]] std::future<ExecutionResultPtr> Transaction::ExecuteAsync(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
+  return ExecuteAsyncImpl(__NR_CALL_STRING_COMPAT_REF(query), args, true,
+                          nullptr);
+}
+
+[[nodiscard]] std::future<ExecutionResultPtr>
+Transaction::ExecuteNonPreparedAsync(const __NR_STRING_COMPAT_REF query,
+                                     const parameters::ParameterArgs& args) {
+  return ExecuteAsyncImpl(__NR_CALL_STRING_COMPAT_REF(query), args, false,
+                          nullptr);
+}
+
+[[nodiscard]] std::future<ExecutionResultPtr>
+Transaction::ExecuteNonPreparedAsync(const __NR_STRING_COMPAT_REF query) {
+  return ExecuteAsyncImpl(__NR_CALL_STRING_COMPAT_REF(query),
+                          parameters::ParameterArgs(), false, nullptr);
+}
+
+std::future<void> Transaction::CommitAsync() {
+  auto self = shared_from_this();
+  return impl::SubmitToTaskPool(task_pool_, type_, [self]() {
+    absl::MutexLock lock(&self->async_mutex_);
+    self->CommitImpl();
+  });
+}
+
+std::future<void> Transaction::RollbackAsync() {
+  auto self = shared_from_this();
+  return impl::SubmitToTaskPool(task_pool_, type_, [self]() {
+    absl::MutexLock lock(&self->async_mutex_);
+    self->RollbackImpl();
+  });
+}
+
+#if __cplusplus >= 202002L
+[[nodiscard]] Awaitable<ExecutionResultPtr> Transaction::ExecuteAwaitable(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
+  auto self = shared_from_this();
+  return Awaitable<ExecutionResultPtr>(
+      task_pool_, type_,
+      [self, sql = __NR_CALL_STRING_COMPAT_REF(query), args]() {
+        absl::MutexLock lock(&self->async_mutex_);
+        return self->ExecuteImpl(sql, args);
+      });
+}
+
+[[nodiscard]] Awaitable<ExecutionResultPtr>
+Transaction::ExecuteNonPreparedAwaitable(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParameterArgs& args) {
+  auto self = shared_from_this();
+  return Awaitable<ExecutionResultPtr>(
+      task_pool_, type_,
+      [self, sql = __NR_CALL_STRING_COMPAT_REF(query), args]() {
+        absl::MutexLock lock(&self->async_mutex_);
+        return self->ExecuteNonPreparedImpl(sql, args);
+      });
+}
+#endif
+
+void Transaction::Commit() {
+  absl::MutexLock lock(&async_mutex_);
+  CommitImpl();
+}
+
+void Transaction::Rollback() {
+  absl::MutexLock lock(&async_mutex_);
+  RollbackImpl();
 }
 
 const StorageType& Transaction::Type() const {
@@ -57,4 +173,63 @@ const TransactionMode& Transaction::Mode() const {
   return mode_;
 }
 
+void Transaction::SetStatementTimeout(std::chrono::milliseconds timeout,
+                                      bool server_side) {
+  statement_timeout_ = timeout;
+  server_side_timeout_ = server_side;
+}
+
+const std::chrono::milliseconds& Transaction::StatementTimeout() const {
+  return statement_timeout_;
+}
+
+bool Transaction::IsAutoCommit() const {
+  return (mode_ & TransactionMode::AutoCommit) == TransactionMode::AutoCommit;
+}
+
+// protected:
+
+ExecutionResultPtr Transaction::ExecuteImpl(
+    const StatementHandle& statement, const parameters::ParamView& args) {
+  return ExecuteImpl(statement.Query(), args);
+}
+
+ExecutionResultPtr Transaction::ExecuteSync(
+    const __NR_STRING_COMPAT_REF query, const parameters::ParamView& args,
+    bool prepared) {
+  absl::MutexLock lock(&async_mutex_);
+  if (prepared) {
+    return ExecuteImpl(query, args);
+  }
+  return ExecuteNonPreparedImpl(query, args);
+}
+
+ExecutionResultPtr Transaction::ExecuteStatement(
+    const StatementHandle& statement, const parameters::ParamView& args) {
+  if (!statement.IsValid()) {
+    throw TransactionException("Execute with invalid StatementHandle", type_);
+  }
+
+  absl::MutexLock lock(&async_mutex_);
+  return ExecuteImpl(statement, args);
+}
+
+std::future<ExecutionResultPtr> Transaction::ExecuteAsyncImpl(
+    std::string query, parameters::ParameterArgs args, bool prepared,
+    std::shared_ptr<void> owner) {
+  // Keep the transaction alive until the task is done,
+  // caller might drop its TransactionPtr before the future resolved.
+  auto self = shared_from_this();
+  return impl::SubmitToTaskPool(
+      task_pool_, type_,
+      [self, sql = std::move(query), params = std::move(args), prepared,
+       owner = std::move(owner)]() {
+        absl::MutexLock lock(&self->async_mutex_);
+        if (prepared) {
+          return self->ExecuteImpl(sql, params);
+        }
+        return self->ExecuteNonPreparedImpl(sql, params);
+      });
+}
+
 NVSERV_END_NAMESPACE
\ No newline at end of file
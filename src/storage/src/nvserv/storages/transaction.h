@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <future>
+#include <memory>
 #include <ostream>
 #include <tuple>
 #include <utility>
@@ -29,15 +32,20 @@
 #include <vector>
 
 #include "nvserv/global_macro.h"
+#include "nvserv/headers/absl_thread.h"
+#include "nvserv/storages/async_execution.h"
 #include "nvserv/storages/declare.h"
 #include "nvserv/storages/execution_result.h"
 #include "nvserv/storages/parameters/param.h"
+#include "nvserv/storages/parameters/param_pack.h"
 #include "nvserv/storages/row_result_iterator.h"
+#include "nvserv/storages/statement_handle.h"
 NVSERV_BEGIN_NAMESPACE(storages)
 
-class Transaction {
+class Transaction : public std::enable_shared_from_this<Transaction> {
  public:
-  Transaction(StorageType type, TransactionMode mode);
+  Transaction(StorageType type, TransactionMode mode,
+              nvm::threads::TaskPoolPtr task_pool = nullptr);
 
   virtual ~Transaction();
 
@@ -76,31 +84,192 @@ class Transaction {
   [[nodiscard]] ExecutionResultPtr ExecuteNonPrepared(
       const __NR_STRING_COMPAT_REF query);
 
+  /// @brief Execute statement prepared with `StorageServer::Prepare`,
+  /// no SQL text lookup on the hot path.
+  [[nodiscard]] ExecutionResultPtr Execute(
+      const StatementHandle& statement,
+      const parameters::ParameterArgs& args);
+
+  template <typename... Args>
+  [[nodiscard]] ExecutionResultPtr Execute(const StatementHandle& statement,
+                                           const Args&... args);
+
+  /// @brief Execute with parameters owned by the pack, see
+  /// parameters::MakeParams. Values are encoded once straight from the
+  /// pack, no parameter container is allocated.
+  template <typename... Ts>
+  [[nodiscard]] ExecutionResultPtr Execute(
+      const __NR_STRING_COMPAT_REF query,
+      const parameters::ParamPack<Ts...>& params);
+
+  template <typename... Ts>
+  [[nodiscard]] ExecutionResultPtr Execute(
+      const StatementHandle& statement,
+      const parameters::ParamPack<Ts...>& params);
+
+  /// @brief Execute with deadline, statement is cancelled on the server
+  /// when still running after `timeout` and QueryTimeoutException thrown.
+  /// Overrides the transaction statement timeout for this call.
+  [[nodiscard]] ExecutionResultPtr Execute(
+      const __NR_STRING_COMPAT_REF query,
+      const parameters::ParameterArgs& args, std::chrono::milliseconds timeout);
+
+  // ExecuteNonPrepared with deadline, see Execute
+  [[nodiscard]] ExecutionResultPtr ExecuteNonPrepared(
+      const __NR_STRING_COMPAT_REF query,
+      const parameters::ParameterArgs& args, std::chrono::milliseconds timeout);
+
+  /// @brief Async variant of Execute, run on the storage TaskPool.
+  /// The values are copied into a parameters::ParamPack owned by the
+  /// execution, temporaries are safe. A parameters::Param argument is
+  /// copied as is, the value it references must stay alive.
+  /// Executions of the same transaction are serialized.
+  template <typename... Args>
+  [[nodiscard]] std::future<ExecutionResultPtr> ExecuteAsync(
+      const __NR_STRING_COMPAT_REF query, const Args&... args);
+
+  [[nodiscard]] std::future<ExecutionResultPtr> ExecuteAsync(
+      const __NR_STRING_COMPAT_REF query);
+
+  /// @brief Params reference the caller's values (see parameters::Param),
+  /// they must stay alive until the future is resolved.
+  [[nodiscard]] std::future<ExecutionResultPtr> ExecuteAsync(
+      const __NR_STRING_COMPAT_REF query,
+      const parameters::ParameterArgs& args);
+
+  // Async variant of ExecuteNonPrepared, run on the storage TaskPool
+  [[nodiscard]] std::future<ExecutionResultPtr> ExecuteNonPreparedAsync(
+      const __NR_STRING_COMPAT_REF query,
+      const parameters::ParameterArgs& args);
+
+  [[nodiscard]] std::future<ExecutionResultPtr> ExecuteNonPreparedAsync(
+      const __NR_STRING_COMPAT_REF query);
+
+  std::future<void> CommitAsync();
+
+  std::future<void> RollbackAsync();
+
+#if __cplusplus >= 202002L
+  // co_await-able variant of Execute, resumed on the storage TaskPool
+  [[nodiscard]] Awaitable<ExecutionResultPtr> ExecuteAwaitable(
+      const __NR_STRING_COMPAT_REF query,
+      const parameters::ParameterArgs& args = parameters::ParameterArgs());
+
+  // co_await-able variant of ExecuteNonPrepared
+  [[nodiscard]] Awaitable<ExecutionResultPtr> ExecuteNonPreparedAwaitable(
+      const __NR_STRING_COMPAT_REF query,
+      const parameters::ParameterArgs& args = parameters::ParameterArgs());
+#endif
+
   const StorageType& Type() const;
 
   const TransactionMode& Mode() const;
 
-  virtual void Commit() = 0;
-  virtual void Rollback() = 0;
+  // True when TransactionMode::AutoCommit flag is set
+  bool IsAutoCommit() const;
+
+  /// @brief Deadline for every following statement, zero disables it.
+  /// Enforced client-side by cancelling the statement on the server.
+  /// @param server_side also mirror it as server statement timeout
+  /// when the driver supports it (postgres: SET LOCAL statement_timeout in
+  /// a block, SET on the session outside one), per-call timeouts included
+  void SetStatementTimeout(std::chrono::milliseconds timeout,
+                           bool server_side = false);
+
+  const std::chrono::milliseconds& StatementTimeout() const;
+
+  // Serialized with the async executions of this transaction
+  void Commit();
+
+  // Serialized with the async executions of this transaction
+  void Rollback();
 
  protected:
   StorageType type_;
   TransactionMode mode_;
+  nvm::threads::TaskPoolPtr task_pool_;
+  std::chrono::milliseconds statement_timeout_;
+  bool server_side_timeout_;
+  // Driver transactions are not thread-safe, synchronous & async
+  // executions on the same transaction run one at a time.
+  absl::Mutex async_mutex_;
+
+  virtual void CommitImpl() = 0;
+
+  virtual void RollbackImpl() = 0;
+
+  // Default run the synchronous Execute on the TaskPool,
+  // driver might override with its own non-blocking engine.
+  // owner keeps the values referenced by args alive (may be null),
+  // hold it as long as args are read.
+  virtual std::future<ExecutionResultPtr> ExecuteAsyncImpl(
+      std::string query, parameters::ParameterArgs args, bool prepared,
+      std::shared_ptr<void> owner);
 
   virtual ExecutionResultPtr ExecuteImpl(
       const __NR_STRING_COMPAT_REF query,
-      const parameters::ParameterArgs& args) = 0;
+      const parameters::ParamView& args) = 0;
 
   virtual ExecutionResultPtr ExecuteNonPreparedImpl(
       const __NR_STRING_COMPAT_REF query,
-      const parameters::ParameterArgs& args) = 0;
+      const parameters::ParamView& args) = 0;
+
+  // Default fallback to execute by the statement SQL text
+  virtual ExecutionResultPtr ExecuteImpl(const StatementHandle& statement,
+                                         const parameters::ParamView& args);
+
+  // Synchronous execution, holds async_mutex_ for the whole call
+  ExecutionResultPtr ExecuteSync(const __NR_STRING_COMPAT_REF query,
+                                 const parameters::ParamView& args,
+                                 bool prepared);
+
+  // Validate the handle before ExecuteImpl, holds async_mutex_
+  ExecutionResultPtr ExecuteStatement(const StatementHandle& statement,
+                                      const parameters::ParamView& args);
 };
 
 template <typename... Args>
 [[nodiscard]] ExecutionResultPtr Transaction::Execute(
     const __NR_STRING_COMPAT_REF query, const Args&... args) {
-  std::vector<parameters::Param> params = {args...};
-  return ExecuteImpl(query, params);
+  // Params reference the arguments, alive for the whole call
+  std::array<parameters::Param, sizeof...(Args)> params = {
+      {parameters::impl::ToParam(args)...}};
+  return ExecuteSync(query, parameters::ParamView(params), true);
+}
+
+template <typename... Args>
+[[nodiscard]] ExecutionResultPtr Transaction::Execute(
+    const StatementHandle& statement, const Args&... args) {
+  std::array<parameters::Param, sizeof...(Args)> params = {
+      {parameters::impl::ToParam(args)...}};
+  return ExecuteStatement(statement, parameters::ParamView(params));
+}
+
+template <typename... Ts>
+[[nodiscard]] ExecutionResultPtr Transaction::Execute(
+    const __NR_STRING_COMPAT_REF query,
+    const parameters::ParamPack<Ts...>& params) {
+  return ExecuteSync(query, params.View(), true);
+}
+
+template <typename... Ts>
+[[nodiscard]] ExecutionResultPtr Transaction::Execute(
+    const StatementHandle& statement,
+    const parameters::ParamPack<Ts...>& params) {
+  return ExecuteStatement(statement, params.View());
+}
+
+template <typename... Args>
+[[nodiscard]] std::future<ExecutionResultPtr> Transaction::ExecuteAsync(
+    const __NR_STRING_COMPAT_REF query, const Args&... args) {
+  // The caller's arguments may be gone before the task runs
+  auto pack = std::make_shared<
+      parameters::ParamPack<parameters::impl::ParamStorageT<Args>...>>(
+      args...);
+  auto view = pack->View();
+  return ExecuteAsyncImpl(__NR_CALL_STRING_COMPAT_REF(query),
+                          parameters::ParameterArgs(view.begin(), view.end()),
+                          true, std::move(pack));
 }
 
 NVSERV_END_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+// Checked in every build type, unlike assert()
+#define NVQL_CHECK(condition)                                              \
+  do {                                                                     \
+    if (!(condition)) {                                                    \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: "       \
+                << #condition << std::endl;                                \
+      std::exit(1);                                                        \
+    }                                                                      \
+  } while (0)
+
+#define NVQL_CHECK_THROWS(expression, exception)                           \
+  do {                                                                     \
+    bool thrown = false;                                                   \
+    try {                                                                  \
+      (void)(expression);                                                  \
+    } catch (const exception&) {                                           \
+      thrown = true;                                                       \
+    }                                                                      \
+    NVQL_CHECK(thrown && #expression " throws " #exception);               \
+  } while (0)
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_binary.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "nvql_test.h"
+
+using namespace nvserv::storages::postgres::helper;
+
+namespace {
+
+void TestIntegers() {
+  for (int16_t value : {int16_t{0}, int16_t{-1}, int16_t{258},
+                        std::numeric_limits<int16_t>::min(),
+                        std::numeric_limits<int16_t>::max()}) {
+    NVQL_CHECK(ReadInteger(WriteInt16(value), oid::INT2) == value);
+  }
+
+  for (int32_t value :
+       {0, -1, 258, std::numeric_limits<int32_t>::min(),
+        std::numeric_limits<int32_t>::max()}) {
+    NVQL_CHECK(ReadInteger(WriteInt32(value), oid::INT4) == value);
+  }
+
+  for (int64_t value :
+       {int64_t{0}, int64_t{-1}, int64_t{1} << 40,
+        std::numeric_limits<int64_t>::min(),
+        std::numeric_limits<int64_t>::max()}) {
+    NVQL_CHECK(ReadInteger(WriteInt64(value), oid::INT8) == value);
+  }
+
+  // Network byte order
+  NVQL_CHECK(WriteInt32(258) == std::string("\0\0\1\2", 4));
+
+  int64_t result = 0;
+  NVQL_CHECK(TryReadInteger(WriteInt16(-7), oid::INT2, result));
+  NVQL_CHECK(result == -7);
+  NVQL_CHECK(!TryReadInteger(WriteInt16(-7), oid::INT4, result));
+  NVQL_CHECK(!TryReadInteger(WriteInt16(-7), oid::TEXT, result));
+
+  NVQL_CHECK_THROWS(ReadInteger(WriteInt16(1), oid::INT8),
+                    std::invalid_argument);
+  NVQL_CHECK_THROWS(ReadInteger(WriteInt32(1), oid::FLOAT8),
+                    std::invalid_argument);
+}
+
+void TestFloats() {
+  for (float value : {0.0f, -1.5f, 3.25f, std::numeric_limits<float>::max(),
+                      std::numeric_limits<float>::lowest()}) {
+    NVQL_CHECK(ReadFloat(WriteFloat4(value), oid::FLOAT4) == value);
+  }
+
+  for (double value : {0.0, -1.5, 1e300, std::numeric_limits<double>::min(),
+                       std::numeric_limits<double>::lowest()}) {
+    NVQL_CHECK(ReadFloat(WriteFloat8(value), oid::FLOAT8) == value);
+  }
+
+  // Integers widen
+  NVQL_CHECK(ReadFloat(WriteInt32(-42), oid::INT4) == -42.0);
+
+  double result = 0;
+  NVQL_CHECK(TryReadFloat(WriteFloat8(2.5), oid::FLOAT8, result));
+  NVQL_CHECK(result == 2.5);
+  NVQL_CHECK(!TryReadFloat(WriteFloat8(2.5), oid::FLOAT4, result));
+}
+
+void TestBool() {
+  NVQL_CHECK(ReadBool(WriteBool(true)));
+  NVQL_CHECK(!ReadBool(WriteBool(false)));
+  NVQL_CHECK(ReadAsText(WriteBool(true), oid::BOOL) == "t");
+  NVQL_CHECK_THROWS(ReadBool(std::string()), std::invalid_argument);
+}
+
+void TestTimestamp() {
+  using std::chrono::microseconds;
+  using std::chrono::system_clock;
+
+  // Postgres epoch, unix epoch (before it) and a negative unix time
+  for (int64_t micros :
+       {int64_t{946684800} * 1000000, int64_t{0}, int64_t{-1},
+        int64_t{1700000000123456}, int64_t{-2208988800} * 1000000}) {
+    system_clock::time_point value(
+        std::chrono::duration_cast<system_clock::duration>(
+            microseconds(micros)));
+    auto binary = WriteTimestamp(value);
+    NVQL_CHECK(binary.size() == 8);
+    NVQL_CHECK(ReadTimestampMicros(binary) == micros);
+    NVQL_CHECK(ReadTimestamp(binary) == value);
+  }
+
+  // 2000-01-01 00:00:00 UTC is zero on the wire
+  system_clock::time_point pg_epoch(std::chrono::seconds(946684800));
+  NVQL_CHECK(WriteTimestamp(pg_epoch) == std::string(8, '\0'));
+}
+
+template <typename T>
+void CheckNumericArray(const std::vector<T>& values, uint32_t element_oid,
+                       uint32_t array_oid) {
+  auto binary = WriteArray(values);
+  uint32_t element_type = 0;
+  auto elements = ReadArray(binary, element_type);
+
+  NVQL_CHECK(element_type == element_oid);
+  NVQL_CHECK(ArrayElementType(array_oid) == element_oid);
+  NVQL_CHECK(elements.size() == values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    if constexpr (std::is_floating_point_v<T>) {
+      NVQL_CHECK(static_cast<T>(ReadFloat(elements[i], element_type)) ==
+                 values[i]);
+    } else {
+      NVQL_CHECK(ReadInteger(elements[i], element_type) == values[i]);
+    }
+  }
+
+  // Same text as the text format, parsed back
+  auto text = ReadAsText(binary, array_oid);
+  NVQL_CHECK(text == FormatArray(values));
+  NVQL_CHECK(ParseArray(text).size() == values.size());
+}
+
+void TestArrays() {
+  CheckNumericArray<int16_t>({1, -2, 300}, oid::INT2, oid::INT2_ARRAY);
+  CheckNumericArray<int32_t>({1, -2, 70000}, oid::INT4, oid::INT4_ARRAY);
+  CheckNumericArray<int64_t>({1, -2, int64_t{1} << 40}, oid::INT8,
+                             oid::INT8_ARRAY);
+  CheckNumericArray<float>({0.5f, -2.25f}, oid::FLOAT4, oid::FLOAT4_ARRAY);
+  CheckNumericArray<double>({0.5, -2.25, 1e10}, oid::FLOAT8,
+                            oid::FLOAT8_ARRAY);
+  CheckNumericArray<int32_t>({}, oid::INT4, oid::INT4_ARRAY);
+
+  std::vector<std::string> strings = {"a", "", "b c", "quote\"d", "back\\s",
+                                      "NULL"};
+  auto binary = WriteArray(strings);
+  uint32_t element_type = 0;
+  auto elements = ReadArray(binary, element_type);
+  NVQL_CHECK(element_type == oid::TEXT);
+  NVQL_CHECK(elements.size() == strings.size());
+  for (size_t i = 0; i < strings.size(); i++) {
+    NVQL_CHECK(elements[i] == strings[i]);
+  }
+
+  // Quoted text survives the round trip, "NULL" included
+  auto text = ReadAsText(binary, oid::TEXT_ARRAY);
+  NVQL_CHECK(text == FormatArray(strings));
+  NVQL_CHECK(ParseArray(text) == strings);
+
+  NVQL_CHECK(ParseArray("{}").empty());
+  NVQL_CHECK(ParseArray("{1,2,3}") ==
+             std::vector<std::string>({"1", "2", "3"}));
+  NVQL_CHECK_THROWS(ParseArray("{1,NULL}"), std::invalid_argument);
+  NVQL_CHECK_THROWS(ParseArray("{{1},{2}}"), std::invalid_argument);
+  NVQL_CHECK_THROWS(ParseArray("{\"open}"), std::invalid_argument);
+  NVQL_CHECK_THROWS(ParseArray("1,2"), std::invalid_argument);
+
+  // Truncated and multi-dimensional binary arrays
+  NVQL_CHECK_THROWS(ReadArray(binary.substr(0, binary.size() - 1),
+                              element_type),
+                    std::invalid_argument);
+  auto two_dimensions = WriteArray(std::vector<int32_t>{1});
+  two_dimensions[3] = 2;
+  NVQL_CHECK_THROWS(ReadArray(two_dimensions, element_type),
+                    std::invalid_argument);
+}
+
+void TestText() {
+  NVQL_CHECK(ReadAsText(WriteInt64(-5), oid::INT8) == "-5");
+  NVQL_CHECK(ReadAsText("abc", oid::VARCHAR) == "abc");
+  NVQL_CHECK(ReadAsText(std::string("\1{}", 3), oid::JSONB) == "{}");
+
+  const unsigned char uuid[16] = {0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc,
+                                  0xde, 0xf0, 0x01, 0x23, 0x45, 0x67,
+                                  0x89, 0xab, 0xcd, 0xef};
+  NVQL_CHECK(FormatUuid(uuid) == "12345678-9abc-def0-0123-456789abcdef");
+  NVQL_CHECK(ReadAsText(std::string(reinterpret_cast<const char*>(uuid), 16),
+                        oid::UUID) == FormatUuid(uuid));
+
+  const unsigned char bytes[3] = {0x00, 0xab, 0xff};
+  NVQL_CHECK(FormatBytea(bytes, 3) == "\\x00abff");
+
+  NVQL_CHECK_THROWS(ReadAsText("x", 0), std::invalid_argument);
+}
+
+}  // namespace
+
+int main() {
+  TestIntegers();
+  TestFloats();
+  TestBool();
+  TestTimestamp();
+  TestArrays();
+  TestText();
+
+  std::cout << "pg_binary_test: ok" << std::endl;
+  return 0;
+}
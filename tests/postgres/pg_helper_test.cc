@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_helper.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "nvql_test.h"
+#include "nvserv/storages/postgres/pg_binary.h"
+
+using namespace nvserv::storages::postgres::helper;
+
+namespace {
+
+constexpr int64_t MICROS = 1000000;
+
+void TestLayout() {
+  NVQL_CHECK(ParseTimestampMicros("1970-01-01 00:00:00") == 0);
+  NVQL_CHECK(ParseTimestampMicros("1970-01-01T00:00:01") == MICROS);
+  NVQL_CHECK(ParseTimestampMicros("2000-01-01 00:00:00") ==
+             946684800 * MICROS);
+  NVQL_CHECK(ParseTimestampMicros("1969-12-31 23:59:59") == -MICROS);
+  NVQL_CHECK(ParseTimestampMicros("2024-02-29 12:34:56") ==
+             1709210096 * MICROS);
+
+  // Fractions, truncated below microseconds
+  NVQL_CHECK(ParseTimestampMicros("1970-01-01 00:00:00.5") == MICROS / 2);
+  NVQL_CHECK(ParseTimestampMicros("1970-01-01 00:00:00.123456") == 123456);
+  NVQL_CHECK(ParseTimestampMicros("1970-01-01 00:00:00.1234569") == 123456);
+
+  // Years beyond 9999 have more digits
+  NVQL_CHECK(ParseTimestampMicros("10000-01-01 00:00:00") ==
+             253402300800 * MICROS);
+}
+
+void TestOffsets() {
+  auto utc = ParseTimestampMicros("2024-01-01 10:00:00");
+  NVQL_CHECK(ParseTimestampMicros("2024-01-01 10:00:00Z") == utc);
+  NVQL_CHECK(ParseTimestampMicros("2024-01-01 10:00:00+00") == utc);
+  NVQL_CHECK(ParseTimestampMicros("2024-01-01 17:00:00+07") == utc);
+  NVQL_CHECK(ParseTimestampMicros("2024-01-01 05:30:00-04:30") == utc);
+  NVQL_CHECK(ParseTimestampMicros("2024-01-01 15:30:00+0530") == utc);
+  NVQL_CHECK(ParseTimestampMicros("2024-01-01 10:53:28+00:53:28") == utc);
+  NVQL_CHECK(ParseTimestampMicros("2024-01-01 17:00:00.25+07") ==
+             utc + MICROS / 4);
+}
+
+void TestInfinity() {
+  NVQL_CHECK(ParseTimestampMicros("infinity") == TIMESTAMP_INFINITY);
+  NVQL_CHECK(ParseTimestampMicros("-infinity") ==
+             TIMESTAMP_NEGATIVE_INFINITY);
+
+  // Same values as the binary format
+  NVQL_CHECK(ReadTimestampMicros(WriteInt64(TIMESTAMP_INFINITY)) ==
+             TIMESTAMP_INFINITY);
+  NVQL_CHECK(ReadTimestampMicros(WriteInt64(TIMESTAMP_NEGATIVE_INFINITY)) ==
+             TIMESTAMP_NEGATIVE_INFINITY);
+
+  NVQL_CHECK(ParseTimestamp("infinity") ==
+             std::chrono::system_clock::time_point::max());
+  NVQL_CHECK(ParseTimestampz("-infinity") ==
+             std::chrono::system_clock::time_point::min());
+  NVQL_CHECK(WriteTimestamp(std::chrono::system_clock::time_point::max()) ==
+             WriteInt64(TIMESTAMP_INFINITY));
+
+  NVQL_CHECK_THROWS(ParseTimestampMicros("Infinity"), std::invalid_argument);
+  NVQL_CHECK_THROWS(ParseTimestampMicros("+infinity"), std::invalid_argument);
+}
+
+void TestBeforeChrist() {
+  // 1 BC is the year before 0001, which was a leap year
+  NVQL_CHECK(ParseTimestampMicros("0001-01-01 00:00:00") -
+                 ParseTimestampMicros("0001-01-01 00:00:00 BC") ==
+             366 * 86400 * MICROS);
+  NVQL_CHECK(ParseTimestampMicros("0001-12-31 23:59:59 BC") ==
+             ParseTimestampMicros("0001-01-01 00:00:00") - MICROS);
+  NVQL_CHECK(ParseTimestampMicros("0044-03-15 12:00:00+00 BC") ==
+             ParseTimestampMicros("0044-03-15 12:00:00 BC"));
+  NVQL_CHECK(ParseTimestampMicros("4713-01-01 00:00:00 BC") <
+             ParseTimestampMicros("0044-03-15 12:00:00 BC"));
+
+  NVQL_CHECK_THROWS(ParseTimestampMicros("0000-01-01 00:00:00 BC"),
+                    std::invalid_argument);
+  NVQL_CHECK_THROWS(ParseTimestampMicros("0001-01-01 00:00:00 AD"),
+                    std::invalid_argument);
+  NVQL_CHECK_THROWS(ParseTimestampMicros("0001-01-01 00:00:00BC"),
+                    std::invalid_argument);
+}
+
+void TestTimePoint() {
+  using std::chrono::system_clock;
+
+  NVQL_CHECK(ParseTimestamp("1970-01-01 00:00:01.5") ==
+             system_clock::time_point(std::chrono::milliseconds(1500)));
+
+  // Beyond the clock range throws rather than wrapping around
+  constexpr auto max_micros =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          system_clock::duration::max())
+          .count();
+  if (max_micros < 253402300800 * MICROS) {
+    NVQL_CHECK_THROWS(ParseTimestamp("9999-12-31 00:00:00"),
+                      std::out_of_range);
+  }
+  NVQL_CHECK_THROWS(MicrosToTimePoint(TIMESTAMP_INFINITY - 1),
+                    std::out_of_range);
+}
+
+void TestFormat() {
+  using std::chrono::system_clock;
+
+  NVQL_CHECK(FormatTimestamp(system_clock::time_point()) ==
+             "1970-01-01 00:00:00");
+  NVQL_CHECK(FormatTimestamp(system_clock::time_point(
+                 std::chrono::microseconds(1709210096 * MICROS + 500))) ==
+             "2024-02-29 12:34:56.000500");
+  NVQL_CHECK(FormatTimestamp(system_clock::time_point(
+                 std::chrono::microseconds(-1))) ==
+             "1969-12-31 23:59:59.999999");
+  NVQL_CHECK(FormatTimestamp(system_clock::time_point::max()) == "infinity");
+  NVQL_CHECK(FormatTimestamp(system_clock::time_point::min()) ==
+             "-infinity");
+
+  // Round trip through the parser, BC years included
+  for (auto value :
+       {"2000-01-01 00:00:00", "1999-12-31 23:59:59.123456",
+        "1900-03-01 06:07:08", "0001-01-01 00:00:00",
+        "0001-12-31 23:59:59 BC", "0044-03-15 12:00:00.500000 BC"}) {
+    auto micros = ParseTimestampMicros(value);
+    auto time_point =
+        system_clock::time_point(std::chrono::microseconds(micros));
+    if (std::chrono::duration_cast<std::chrono::microseconds>(
+            time_point.time_since_epoch())
+            .count() != micros) {
+      // Beyond the clock range
+      continue;
+    }
+    NVQL_CHECK(FormatTimestamp(time_point) == value);
+  }
+}
+
+void TestMalformed() {
+  for (auto value :
+       {"", "2024", "2024-01-01", "2024-01-01 10:00", "24-01-01 10:00:00",
+        "2024-1-01 10:00:00", "2024-13-01 10:00:00", "2024-01-32 10:00:00",
+        "2024-01-01 10:60:00", "2024-01-01x10:00:00", "2024-01-01 10:00:00.",
+        "2024-01-01 10:00:00+", "2024-01-01 10:00:00 ", "2024-01-01 10:00:00x",
+        "infinityx"}) {
+    NVQL_CHECK_THROWS(ParseTimestampMicros(value), std::invalid_argument);
+  }
+}
+
+}  // namespace
+
+int main() {
+  TestLayout();
+  TestOffsets();
+  TestInfinity();
+  TestBeforeChrist();
+  TestTimePoint();
+  TestFormat();
+  TestMalformed();
+
+  std::cout << "pg_helper_test: ok" << std::endl;
+  return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/postgres/pg_param_buffer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "nvql_test.h"
+#include "nvserv/storages/postgres/pg_binary.h"
+
+using namespace nvserv::storages;
+namespace oid = nvserv::storages::postgres::helper::oid;
+
+namespace {
+
+std::string ValueAt(const postgres::PgParamBuffer& buffer, int i) {
+  return std::string(buffer.Values()[i], buffer.Lengths()[i]);
+}
+
+void TestDeclareFromParams() {
+  postgres::PgParamBuffer buffer;
+  auto params = parameters::MakeParams(int32_t{258}, std::string("hello"),
+                                       true, int64_t{5});
+  buffer.Encode(params, nullptr, true);
+
+  NVQL_CHECK(buffer.Size() == 4);
+  NVQL_CHECK(buffer.Formats()[0] == 1);
+  NVQL_CHECK(buffer.Types()[0] == oid::INT4);
+  NVQL_CHECK(ValueAt(buffer, 0) == postgres::helper::WriteInt32(258));
+
+  // Strings stay text, the server infers them
+  NVQL_CHECK(buffer.Formats()[1] == 0);
+  NVQL_CHECK(buffer.Types()[1] == 0);
+  NVQL_CHECK(std::strcmp(buffer.Values()[1], "hello") == 0);
+
+  NVQL_CHECK(buffer.Formats()[2] == 1);
+  NVQL_CHECK(buffer.Types()[2] == oid::BOOL);
+  NVQL_CHECK(buffer.Types()[3] == oid::INT8);
+  NVQL_CHECK(postgres::helper::ReadInteger(ValueAt(buffer, 3), oid::INT8) ==
+             5);
+}
+
+void TestDeclaredTypes() {
+  postgres::PgParamBuffer buffer;
+  auto params = parameters::MakeParams(int32_t{258}, std::string("hello"),
+                                       true, int64_t{5});
+
+  // int8 value of an int4 parameter goes as text
+  std::vector<uint32_t> declared = {oid::INT4, oid::TEXT, oid::BOOL,
+                                    oid::INT4};
+  buffer.Encode(params, &declared, true);
+  NVQL_CHECK(buffer.Formats()[0] == 1);
+  NVQL_CHECK(buffer.Formats()[2] == 1);
+  NVQL_CHECK(buffer.Formats()[3] == 0);
+  NVQL_CHECK(std::strcmp(buffer.Values()[3], "5") == 0);
+  for (int i = 0; i < buffer.Size(); i++) {
+    NVQL_CHECK(buffer.Types()[i] == declared[i]);
+  }
+
+  // Prepared with inferred types, everything goes as text
+  std::vector<uint32_t> inferred;
+  buffer.Encode(params, &inferred, true);
+  for (int i = 0; i < buffer.Size(); i++) {
+    NVQL_CHECK(buffer.Formats()[i] == 0);
+    NVQL_CHECK(buffer.Types()[i] == 0);
+  }
+  NVQL_CHECK(std::strcmp(buffer.Values()[0], "258") == 0);
+  NVQL_CHECK(std::strcmp(buffer.Values()[2], "t") == 0);
+
+  // Shorter than the parameters, the rest is inferred
+  std::vector<uint32_t> partial = {oid::INT4};
+  buffer.Encode(params, &partial, true);
+  NVQL_CHECK(buffer.Formats()[0] == 1);
+  NVQL_CHECK(buffer.Types()[0] == oid::INT4);
+  NVQL_CHECK(buffer.Formats()[3] == 0);
+  NVQL_CHECK(buffer.Types()[3] == 0);
+}
+
+void TestText() {
+  postgres::PgParamBuffer buffer;
+  auto params = parameters::MakeParams(
+      int32_t{258}, true,
+      std::chrono::system_clock::time_point(std::chrono::hours(24)));
+  buffer.Encode(params, nullptr, false);
+
+  NVQL_CHECK(buffer.Size() == 3);
+  NVQL_CHECK(std::strcmp(buffer.Values()[0], "258") == 0);
+  NVQL_CHECK(std::strcmp(buffer.Values()[1], "t") == 0);
+  NVQL_CHECK(std::strcmp(buffer.Values()[2], "1970-01-02 00:00:00") == 0);
+  NVQL_CHECK(buffer.Types()[0] == 0);
+  NVQL_CHECK(buffer.Formats()[1] == 0);
+
+  // Reused buffer drops the previous content
+  buffer.Encode(parameters::MakeParams(std::string("x")), nullptr, true);
+  NVQL_CHECK(buffer.Size() == 1);
+  NVQL_CHECK(ValueAt(buffer, 0) == "x");
+}
+
+}  // namespace
+
+int main() {
+  TestDeclareFromParams();
+  TestDeclaredTypes();
+  TestText();
+
+  std::cout << "pg_param_buffer_test: ok" << std::endl;
+  return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Linggawasistha Djohari
+ * <linggawasistha.djohari@outlook.com>
+ * Licensed to Linggawasistha Djohari under one or more contributor license
+ * agreements.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership.
+ *
+ *  Linggawasistha Djohari licenses this file to you under the Apache License,
+ *  Version 2.0 (the "License"); you may not use this file except in
+ *  compliance with the License. You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "nvserv/storages/column_set.h"
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "nvql_test.h"
+
+using namespace nvserv::storages;
+
+namespace {
+
+// Row i is null when i % 3 == 0, otherwise holds i
+ColumnVector MakeInt64s(size_t begin, size_t end) {
+  ColumnVector column("id", ColumnKind::Int64);
+  for (size_t i = begin; i < end; i++) {
+    if (i % 3 == 0) {
+      column.AppendNull();
+    } else {
+      column.AppendInt64(static_cast<int64_t>(i));
+    }
+  }
+  return column;
+}
+
+ColumnVector MakeStrings(size_t begin, size_t end) {
+  ColumnVector column("name", ColumnKind::String);
+  for (size_t i = begin; i < end; i++) {
+    if (i % 3 == 0) {
+      column.AppendNull();
+    } else {
+      column.AppendString(std::string(i % 5, 'a' + i % 26));
+    }
+  }
+  return column;
+}
+
+void CheckInt64s(const ColumnVector& column, size_t rows) {
+  auto expected = MakeInt64s(0, rows);
+  NVQL_CHECK(column.Size() == rows);
+  NVQL_CHECK(column.NullCount() == expected.NullCount());
+  NVQL_CHECK(column.Validity() == expected.Validity());
+  NVQL_CHECK(column.Int64s() == expected.Int64s());
+}
+
+void CheckStrings(const ColumnVector& column, size_t rows) {
+  auto expected = MakeStrings(0, rows);
+  NVQL_CHECK(column.Size() == rows);
+  NVQL_CHECK(column.NullCount() == expected.NullCount());
+  NVQL_CHECK(column.Validity() == expected.Validity());
+  NVQL_CHECK(column.Offsets() == expected.Offsets());
+  NVQL_CHECK(column.Data() == expected.Data());
+}
+
+void TestAppendChunks() {
+  // Chunk boundaries on whole validity bytes, as ToColumns splits them
+  auto ids = MakeInt64s(0, 16);
+  ids.Append(MakeInt64s(16, 32));
+  ids.Append(MakeInt64s(32, 37));
+  CheckInt64s(ids, 37);
+
+  auto names = MakeStrings(0, 8);
+  names.Append(MakeStrings(8, 24));
+  names.Append(MakeStrings(24, 29));
+  CheckStrings(names, 29);
+}
+
+void TestAppendUnaligned() {
+  auto ids = MakeInt64s(0, 5);
+  ids.Append(MakeInt64s(5, 19));
+  ids.Append(MakeInt64s(19, 19));
+  CheckInt64s(ids, 19);
+
+  auto names = MakeStrings(0, 3);
+  names.Append(MakeStrings(3, 11));
+  CheckStrings(names, 11);
+  NVQL_CHECK(names.StringAt(10) == MakeStrings(10, 11).StringAt(0));
+}
+
+void TestAppendKindMismatch() {
+  auto ids = MakeInt64s(0, 4);
+  NVQL_CHECK_THROWS(ids.Append(MakeStrings(4, 8)), std::invalid_argument);
+  NVQL_CHECK(ids.Size() == 4);
+}
+
+}  // namespace
+
+int main() {
+  TestAppendChunks();
+  TestAppendUnaligned();
+  TestAppendKindMismatch();
+
+  std::cout << "column_set_test: ok" << std::endl;
+  return 0;
+}